@@ -61,12 +61,13 @@ AssemblyItem const& Assembly::append(AssemblyItem _i)
 
 unsigned Assembly::codeSize(unsigned subTagSize) const
 {
+	size_t dataSize = 1;
+	for (auto const& i: m_data)
+		dataSize += i.second.size();
+
 	for (unsigned tagSize = subTagSize; true; ++tagSize)
 	{
-		size_t ret = 1;
-		for (auto const& i: m_data)
-			ret += i.second.size();
-
+		size_t ret = dataSize;
 		for (AssemblyItem const& i: m_items)
 			ret += i.bytesRequired(tagSize, Precision::Approximate);
 		if (numberEncodingSize(ret) <= tagSize)
@@ -429,10 +430,14 @@ map<u256, u256> const& Assembly::optimiseInternal(
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
 
+			// The expression classes are only valid for a single block, but their memory
+			// is reused across blocks.
+			auto expressionClasses = make_shared<ExpressionClasses>();
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
+				expressionClasses->clear();
+				KnownState emptyState{expressionClasses};
 				CommonSubexpressionEliminator eliminator{emptyState};
 				auto orig = iter;
 				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
@@ -532,7 +537,9 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesRequiredForCode = codeSize(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, numeric_limits<size_t>::max());
-	map<size_t, pair<size_t, size_t>> tagRef;
+	/// Pairs of bytecode offsets and (sub id, tag id) of the tag to be inserted there,
+	/// in order of increasing offset.
+	vector<pair<size_t, pair<size_t, size_t>>> tagRef;
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
@@ -570,7 +577,7 @@ LinkerObject const& Assembly::assemble() const
 		case PushTag:
 		{
 			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			tagRef.emplace_back(ret.bytecode.size(), i.splitForeignPushTag());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
@@ -679,24 +686,23 @@ LinkerObject const& Assembly::assemble() const
 		// Append an INVALID here to help tests find miscompilation.
 		ret.bytecode.push_back(static_cast<uint8_t>(Instruction::INVALID));
 
-	map<LinkerObject, size_t> subAssemblyOffsets;
+	// The assembled sub-objects are owned by the sub-assemblies, so they are only referenced here
+	// and compared by value.
+	auto const compareLinkerObjects = [](LinkerObject const* _lhs, LinkerObject const* _rhs) { return *_lhs < *_rhs; };
+	map<LinkerObject const*, size_t, decltype(compareLinkerObjects)> subAssemblyOffsets(compareLinkerObjects);
 	for (auto const& [subIdPath, bytecodeOffset]: subRef)
 	{
-		LinkerObject subObject = subAssemblyById(subIdPath)->assemble();
+		LinkerObject const& subObject = subAssemblyById(subIdPath)->assemble();
 		bytesRef r(ret.bytecode.data() + bytecodeOffset, bytesPerDataRef);
 
 		// In order for de-duplication to kick in, not only must the bytecode be identical, but
 		// link and immutables references as well.
-		if (size_t* subAssemblyOffset = util::valueOrNullptr(subAssemblyOffsets, subObject))
-			toBigEndian(*subAssemblyOffset, r);
-		else
-		{
-			toBigEndian(ret.bytecode.size(), r);
-			subAssemblyOffsets[subObject] = ret.bytecode.size();
+		auto [subAssemblyOffset, inserted] = subAssemblyOffsets.emplace(&subObject, ret.bytecode.size());
+		toBigEndian(subAssemblyOffset->second, r);
+		if (inserted)
 			ret.bytecode += subObject.bytecode;
-		}
 		for (auto const& ref: subObject.linkReferences)
-			ret.linkReferences[ref.first + subAssemblyOffsets[subObject]] = ref.second;
+			ret.linkReferences[ref.first + subAssemblyOffset->second] = ref.second;
 	}
 	for (auto const& i: tagRef)
 	{
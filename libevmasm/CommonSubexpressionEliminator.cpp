@@ -331,7 +331,7 @@ void CSECodeGenerator::generateClassElement(Id _c, bool _allowSequenced)
 		OptimizerException,
 		"Undefined item requested but not available."
 	);
-	vector<Id> const& arguments = expr.arguments;
+	ExpressionClasses::Arguments const& arguments = expr.arguments;
 	for (Id arg: arguments | ranges::views::reverse)
 		generateClassElement(arg);
 
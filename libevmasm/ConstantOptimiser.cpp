@@ -24,10 +24,43 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
+namespace
+{
+
+/// Cache of the routines found by ComputeMethod, keyed by the value and all
+/// parameters that influence the gas estimate.
+/// Guarded by a mutex so that it can be shared by concurrent compilations.
+/// Holds at most maxEntries routines, the least recently used one is dropped first,
+/// so that long-running processes like the language server do not grow without bound.
+struct ComputeMethodCache
+{
+	using Key = tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+
+	static size_t constexpr maxEntries = 4096;
+
+	mutex lock;
+	/// Keys ordered from the most to the least recently used one.
+	list<Key> recentlyUsed;
+	map<Key, pair<AssemblyItems, list<Key>::iterator>> routines;
+};
+
+ComputeMethodCache& computeMethodCache()
+{
+	static ComputeMethodCache cache;
+	return cache;
+}
+
+}
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -187,6 +220,57 @@ AssemblyItems const& CodeCopyMethod::copyRoutine()
 	return copyRoutine;
 }
 
+ComputeMethod::ComputeMethod(Params const& _params, u256 const& _value):
+	ConstantOptimisationMethod(_params, _value)
+{
+	ComputeMethodCache& cache = computeMethodCache();
+	ComputeMethodCache::Key key{
+		m_value,
+		m_params.isCreation,
+		m_params.runs,
+		m_params.multiplicity,
+		m_params.evmVersion
+	};
+
+	{
+		lock_guard<mutex> guard(cache.lock);
+		auto it = cache.routines.find(key);
+		if (it != cache.routines.end())
+		{
+			cache.recentlyUsed.splice(cache.recentlyUsed.begin(), cache.recentlyUsed, it->second.second);
+			m_routine = it->second.first;
+			return;
+		}
+	}
+
+	m_routine = findRepresentation(m_value);
+	assertThrow(
+		checkRepresentation(m_value, m_routine),
+		OptimizerException,
+		"Invalid constant expression created."
+	);
+
+	lock_guard<mutex> guard(cache.lock);
+	// Another thread may have stored the same routine in the meantime.
+	if (cache.routines.count(key))
+		return;
+	if (cache.routines.size() >= ComputeMethodCache::maxEntries)
+	{
+		cache.routines.erase(cache.recentlyUsed.back());
+		cache.recentlyUsed.pop_back();
+	}
+	cache.recentlyUsed.push_front(key);
+	cache.routines.emplace(std::move(key), make_pair(m_routine, cache.recentlyUsed.begin()));
+}
+
+void ComputeMethod::clearCache()
+{
+	ComputeMethodCache& cache = computeMethodCache();
+	lock_guard<mutex> guard(cache.lock);
+	cache.routines.clear();
+	cache.recentlyUsed.clear();
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
@@ -128,20 +128,16 @@ protected:
 
 /**
  * Method that tries to compute the constant.
+ *
+ * The routine found for a constant only depends on the constant and on the optimisation
+ * parameters, so it is stored in a process-wide cache and shared between all assemblies
+ * and sub-assemblies instead of being searched for again. The cache is bounded and drops
+ * the least recently used routines first.
  */
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
-	{
-		m_routine = findRepresentation(m_value);
-		assertThrow(
-			checkRepresentation(m_value, m_routine),
-			OptimizerException,
-			"Invalid constant expression created."
-		);
-	}
+	explicit ComputeMethod(Params const& _params, u256 const& _value);
 
 	bigint gasNeeded() const override { return gasNeeded(m_routine); }
 	AssemblyItems execute(Assembly&) const override
@@ -149,6 +145,9 @@ public:
 		return m_routine;
 	}
 
+	/// Removes all entries from the shared routine cache.
+	static void clearCache();
+
 protected:
 	/// Tries to recursively find a way to compute @a _value.
 	AssemblyItems findRepresentation(u256 const& _value);
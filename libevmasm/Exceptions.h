@@ -31,6 +31,7 @@ struct AssemblyException: virtual util::Exception {};
 struct OptimizerException: virtual AssemblyException {};
 struct StackTooDeepException: virtual OptimizerException {};
 struct ItemNotAvailableException: virtual OptimizerException {};
+struct InvalidLinkReference: virtual util::Exception {};
 
 DEV_SIMPLE_EXCEPTION(InvalidDeposit);
 DEV_SIMPLE_EXCEPTION(InvalidOpcode);
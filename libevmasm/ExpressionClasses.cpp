@@ -86,7 +86,7 @@ ExpressionClasses::Id ExpressionClasses::find(
 	Expression exp;
 	exp.id = Id(-1);
 	exp.item = &_item;
-	exp.arguments = _arguments;
+	exp.arguments.assign(_arguments.begin(), _arguments.end());
 	exp.sequenceNumber = _sequenceNumber;
 
 	if (SemanticInformation::isCommutativeOperation(_item))
@@ -124,7 +124,7 @@ void ExpressionClasses::forceEqual(
 	Expression exp;
 	exp.id = _id;
 	exp.item = &_item;
-	exp.arguments = _arguments;
+	exp.arguments.assign(_arguments.begin(), _arguments.end());
 
 	if (SemanticInformation::isCommutativeOperation(_item))
 		sort(exp.arguments.begin(), exp.arguments.end());
@@ -135,6 +135,13 @@ void ExpressionClasses::forceEqual(
 	m_expressions.insert(exp);
 }
 
+void ExpressionClasses::clear()
+{
+	m_representatives.clear();
+	m_expressions.clear();
+	m_spareAssemblyItems.clear();
+}
+
 ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _location)
 {
 	Expression exp;
@@ -181,8 +188,8 @@ u256 const* ExpressionClasses::knownConstant(Id _c)
 
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
 {
-	m_spareAssemblyItems.push_back(make_shared<AssemblyItem>(_item));
-	return m_spareAssemblyItems.back().get();
+	m_spareAssemblyItems.push_back(_item);
+	return &m_spareAssemblyItems.back();
 }
 
 string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
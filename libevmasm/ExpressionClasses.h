@@ -28,6 +28,9 @@
 
 #include <libsolutil/Common.h>
 
+#include <boost/container/small_vector.hpp>
+
+#include <deque>
 #include <memory>
 #include <unordered_set>
 #include <vector>
@@ -52,12 +55,15 @@ class ExpressionClasses
 public:
 	using Id = unsigned;
 	using Ids = std::vector<Id>;
+	/// Arguments of an expression, stored inline since no operation takes more than three
+	/// arguments in the common case.
+	using Arguments = boost::container::small_vector<Id, 3>;
 
 	struct Expression
 	{
 		Id id;
 		AssemblyItem const* item = nullptr;
-		Ids arguments;
+		Arguments arguments;
 		/// Storage modification sequence, only used for storage and memory operations.
 		unsigned sequenceNumber = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
@@ -85,6 +91,9 @@ public:
 	Expression const& representative(Id _id) const { return m_representatives.at(_id); }
 	/// @returns the number of classes.
 	size_t size() const { return m_representatives.size(); }
+	/// Removes all classes and stored items, but keeps the allocated memory so that
+	/// the object can be reused for the next basic block.
+	void clear();
 
 	/// Forces the given @a _item with @a _arguments to the class @a _id. This can be used to
 	/// add prior knowledge e.g. about CALLDATA, but has to be used with caution. Will not work as
@@ -129,7 +138,9 @@ private:
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
 	std::unordered_set<Expression, Expression::ExpressionHash> m_expressions;
-	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
+	/// Copies of assembly items referenced by expressions. A deque is used since it
+	/// does not move its elements when growing.
+	std::deque<AssemblyItem> m_spareAssemblyItems;
 };
 
 }
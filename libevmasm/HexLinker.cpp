@@ -0,0 +1,111 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libevmasm/HexLinker.h>
+
+#include <libevmasm/Exceptions.h>
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/// Library placeholders are 40 hex digits (20 bytes) that start and end with '__'.
+size_t constexpr placeholderSize = 40;
+/// Every hint is a line that starts with this prefix, followed by the placeholder without
+/// the enclosing '__'.
+string const hintPrefix = "\n// ";
+
+}
+
+HexLinker::HexLinker(map<string, h160> const& _libraries)
+{
+	for (auto const& [name, address]: _libraries)
+	{
+		string const addressHex = util::toHex(address.asBytes());
+		// This leaves 36 characters for the library identifier. The identifier used to
+		// be just the cropped or '_'-padded library name, but this changed to
+		// the cropped hex representation of the hash of the library name.
+		// We support both ways of linking here.
+		string const placeholder = LinkerObject::libraryPlaceholder(name);
+		m_addresses["__" + placeholder + "__"] = addressHex;
+		m_hints[placeholder] = "\n" + libraryPlaceholderHint(name);
+
+		string replacement = "__";
+		for (size_t i = 0; i < placeholderSize - 4; ++i)
+			replacement.push_back(i < name.size() ? name[i] : '_');
+		replacement += "__";
+		m_addresses[replacement] = addressHex;
+	}
+}
+
+vector<HexLinker::UnresolvedReference> HexLinker::link(string& _hexCode) const
+{
+	vector<UnresolvedReference> unresolved;
+	for (size_t pos = _hexCode.find('_'); pos != string::npos; pos = _hexCode.find('_', pos))
+	{
+		if (
+			_hexCode.size() - pos < placeholderSize ||
+			_hexCode[pos + 1] != '_' ||
+			_hexCode[pos + placeholderSize - 2] != '_' ||
+			_hexCode[pos + placeholderSize - 1] != '_'
+		)
+			solThrow(
+				InvalidLinkReference,
+				"at position " + to_string(pos) + "\n" +
+				'"' + _hexCode.substr(pos, placeholderSize) + "\" is not a valid link reference."
+			);
+
+		string placeholder = _hexCode.substr(pos, placeholderSize);
+		if (string const* address = valueOrNullptr(m_addresses, placeholder))
+			_hexCode.replace(pos, placeholderSize, *address);
+		else
+			unresolved.push_back({std::move(placeholder), pos});
+		pos += placeholderSize;
+	}
+
+	// Remove hints for resolved libraries. The hints of unresolved libraries stay.
+	for (
+		size_t pos = _hexCode.find(hintPrefix);
+		pos != string::npos;
+		pos = _hexCode.find(hintPrefix, pos)
+	)
+	{
+		string const* hint = valueOrNullptr(m_hints, _hexCode.substr(pos + hintPrefix.size(), placeholderSize - 4));
+		if (hint && _hexCode.compare(pos, hint->size(), *hint) == 0)
+			_hexCode.erase(pos, hint->size());
+		else
+			pos += hintPrefix.size();
+	}
+	while (!_hexCode.empty() && _hexCode.back() == '\n')
+		_hexCode.pop_back();
+
+	return unresolved;
+}
+
+string HexLinker::libraryPlaceholderHint(string const& _libraryName)
+{
+	return "// " + LinkerObject::libraryPlaceholder(_libraryName) + " -> " + _libraryName;
+}
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Linker for the hex representation of bytecode, as produced by solc --bin.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Links the hex representation of many objects against the same set of libraries.
+ *
+ * Everything that only depends on the libraries (the placeholders of both the current and
+ * the old, name-based format, the hex form of the addresses and the hints that follow
+ * unlinked bytecode) is computed once on construction, so that linking one more object only
+ * costs a single scan over its text. Linking does not modify the linker, so one instance can
+ * be used from several threads at the same time.
+ */
+class HexLinker
+{
+public:
+	/// A link reference that could not be resolved because its library was not given.
+	struct UnresolvedReference
+	{
+		/// The placeholder, including the enclosing `__`.
+		std::string placeholder;
+		/// Offset of the placeholder in the hex text.
+		size_t position = 0;
+
+		bool operator==(UnresolvedReference const& _other) const
+		{
+			return placeholder == _other.placeholder && position == _other.position;
+		}
+	};
+
+	/// @param _libraries map from library names (optionally qualified with the source unit name)
+	/// to their addresses.
+	explicit HexLinker(std::map<std::string, util::h160> const& _libraries);
+
+	/// Replaces the placeholders of all given libraries in @a _hexCode by their addresses and
+	/// removes the hints of these libraries. Trailing newlines are removed as well.
+	/// @throws InvalidLinkReference if @a _hexCode contains an underscore that does not start
+	/// a complete placeholder.
+	/// @returns the placeholders that could not be resolved, in the order of their appearance.
+	std::vector<UnresolvedReference> link(std::string& _hexCode) const;
+
+	/// @returns the hint that is appended to unlinked bytecode for a reference to @a _libraryName.
+	static std::string libraryPlaceholderHint(std::string const& _libraryName);
+
+private:
+	/// Map from placeholders, including the enclosing `__`, to the hex representation of the
+	/// address that replaces them.
+	std::map<std::string, std::string> m_addresses;
+	/// Map from placeholders, without the enclosing `__`, to the hints of their libraries.
+	std::map<std::string, std::string> m_hints;
+};
+
+}
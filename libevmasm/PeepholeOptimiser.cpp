@@ -25,6 +25,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <array>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -79,6 +81,7 @@ struct SimplePeepholeOptimizerMethod
 
 struct Identity: SimplePeepholeOptimizerMethod<Identity>
 {
+	static bool canStartWith(AssemblyItem const&) { return true; }
 	static bool applySimple(
 		AssemblyItem const& _item,
 		back_insert_iterator<AssemblyItems> _out
@@ -91,6 +94,14 @@ struct Identity: SimplePeepholeOptimizerMethod<Identity>
 
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		auto t = _item.type();
+		return
+			SemanticInformation::isDupInstruction(_item) ||
+			t == Push || t == PushTag || t == PushSub ||
+			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress;
+	}
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _pop,
@@ -108,6 +119,10 @@ struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == Operation;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _pop,
@@ -130,6 +145,10 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 
 struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == Operation || _item.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _stop,
@@ -159,6 +178,10 @@ struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 
 struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == Operation || _item.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _push,
@@ -188,6 +211,10 @@ struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return SemanticInformation::isSwapInstruction(_item);
+	}
 	static size_t applySimple(
 		AssemblyItem const& _s1,
 		AssemblyItem const& _s2,
@@ -200,6 +227,10 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 
 struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _push1,
 		AssemblyItem const& _push2,
@@ -219,6 +250,10 @@ struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush>
 
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item == Instruction::SWAP1;
+	}
 	static bool applySimple(
 		AssemblyItem const& _swap,
 		AssemblyItem const& _op,
@@ -241,6 +276,10 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item == Instruction::SWAP1;
+	}
 	static bool applySimple(
 		AssemblyItem const& _swap,
 		AssemblyItem const& _op,
@@ -271,6 +310,10 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 /// Remove swapN after dupN
 struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return SemanticInformation::isDupInstruction(_item);
+	}
 	static size_t applySimple(
 		AssemblyItem const& _dupN,
 		AssemblyItem const& _swapN,
@@ -294,6 +337,10 @@ struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 
 struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item == Instruction::ISZERO;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -320,6 +367,10 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 
 struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item == Instruction::EQ;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _eq,
 		AssemblyItem const& _iszero,
@@ -348,6 +399,10 @@ struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 // push_tag_1 jumpi push_tag_2 jump tag_1: -> iszero push_tag_2 jumpi tag_1:
 struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == PushTag;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _pushTag1,
 		AssemblyItem const& _jumpi,
@@ -379,6 +434,10 @@ struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == PushTag;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _jump,
@@ -405,6 +464,10 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == PushTag || _item.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _pushConstant,
@@ -440,6 +503,10 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _not,
@@ -458,6 +525,17 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	static bool canStartWith(AssemblyItem const& _item)
+	{
+		return
+			_item == Instruction::JUMP ||
+			_item == Instruction::RETURN ||
+			_item == Instruction::STOP ||
+			_item == Instruction::INVALID ||
+			_item == Instruction::SELFDESTRUCT ||
+			_item == Instruction::REVERT;
+	}
+
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
@@ -488,16 +566,57 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+/// Bit set of methods, the lowest bit corresponding to the method that is tried first.
+using MethodMask = uint32_t;
+
+/// Operations are dispatched on their opcode, all other items on their type.
+size_t constexpr dispatchTableSize = 0x100 + VerbatimBytecode + 1;
+
+size_t dispatchKey(AssemblyItem const& _item)
+{
+	if (_item.type() == Operation)
+		return static_cast<uint8_t>(_item.instruction());
+	else
+		return 0x100 + static_cast<size_t>(_item.type());
+}
+
+/// @returns a table that maps the dispatch key of the first item of a window to the set
+/// of methods that can possibly match a window starting with such an item.
+template <typename... Methods>
+array<MethodMask, dispatchTableSize> buildDispatchTable()
+{
+	static_assert(sizeof...(Methods) <= 8 * sizeof(MethodMask), "Too many peephole optimisation methods.");
+	array<MethodMask, dispatchTableSize> table{};
+	for (size_t key = 0; key < dispatchTableSize; ++key)
+	{
+		AssemblyItem item = key < 0x100 ?
+			AssemblyItem(Operation, key) :
+			AssemblyItem(static_cast<AssemblyItemType>(key - 0x100));
+		MethodMask bit = 1;
+		((table[key] |= (Methods::canStartWith(item) ? bit : 0), bit <<= 1), ...);
+	}
+	return table;
+}
+
+void applyMatchingMethods(OptimiserState&, MethodMask)
 {
 	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
 }
 
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+void applyMatchingMethods(OptimiserState& _state, MethodMask _candidates, Method, OtherMethods... _other)
+{
+	if (!(_candidates & 1) || !Method::apply(_state))
+		applyMatchingMethods(_state, _candidates >> 1, _other...);
+}
+
+/// Applies the first of @a Methods that matches at the current position, only trying
+/// those that can start with the current item.
+template <typename... Methods>
+void applyMethods(OptimiserState& _state)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	static array<MethodMask, dispatchTableSize> const dispatchTable = buildDispatchTable<Methods...>();
+	applyMatchingMethods(_state, dispatchTable[dispatchKey(_state.items[_state.i])], Methods()...);
 }
 
 size_t numberOfPops(AssemblyItems const& _items)
@@ -513,12 +632,11 @@ bool PeepholeOptimiser::optimise()
 	auto const approx = evmasm::Precision::Approximate;
 	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems)};
 	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
+		applyMethods<
+			PushPop, OpPop, OpStop, OpReturnRevert, DoublePush, DoubleSwap, CommutativeSwap, SwapComparison,
+			DupSwap, IsZeroIsZeroJumpI, EqIsZeroJumpI, DoubleJump, JumpToNext, UnreachableCode,
+			TagConjunctions, TruthyAnd, Identity
+		>(state);
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3, approx) < evmasm::bytesRequired(m_items, 3, approx) ||
@@ -51,10 +51,29 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/MappedFile.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
 
+CharStream::CharStream(string _source, string _name, bool _importedFromAST):
+	m_name(std::move(_name)),
+	m_importedFromAST(_importedFromAST)
+{
+	auto source = make_shared<string const>(std::move(_source));
+	m_source = *source;
+	m_storage = std::move(source);
+}
+
+CharStream::CharStream(shared_ptr<util::MappedFile const> _file, string _name):
+	m_name(std::move(_name))
+{
+	solAssert(_file, "");
+	m_source = _file->contents();
+	m_storage = std::move(_file);
+}
+
 char CharStream::advanceAndGet(size_t _chars)
 {
 	if (isPastEndOfInput())
@@ -91,10 +110,10 @@ string CharStream::lineAtPosition(int _position) const
 		lineStart = 0;
 	else
 		lineStart++;
-	string line = m_source.substr(
+	string line{m_source.substr(
 		lineStart,
 		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	)};
 	if (!line.empty() && line.back() == '\r')
 		line.pop_back();
 	return line;
@@ -123,13 +142,13 @@ string_view CharStream::text(SourceLocation const& _location) const
 		return {};
 	solAssert(_location.sourceName && *_location.sourceName == m_name, "");
 	solAssert(static_cast<size_t>(_location.end) <= m_source.size(), "");
-	return string_view{m_source}.substr(
+	return m_source.substr(
 		static_cast<size_t>(_location.start),
 		static_cast<size_t>(_location.end - _location.start)
 	);
 }
 
-string CharStream::singleLineSnippet(string const& _sourceCode, SourceLocation const& _location)
+string CharStream::singleLineSnippet(string_view _sourceCode, SourceLocation const& _location)
 {
 	if (!_location.hasText())
 		return {};
@@ -137,7 +156,7 @@ string CharStream::singleLineSnippet(string const& _sourceCode, SourceLocation c
 	if (static_cast<size_t>(_location.start) >= _sourceCode.size())
 		return {};
 
-	string cut = _sourceCode.substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start));
+	string cut{_sourceCode.substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start))};
 	auto newLinePos = cut.find_first_of("\n\r");
 	if (newLinePos != string::npos)
 		cut = cut.substr(0, newLinePos) + "...";
@@ -150,7 +169,7 @@ optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineC
 	return translateLineColumnToPosition(m_source, _lineColumn);
 }
 
-optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
+optional<int> CharStream::translateLineColumnToPosition(string_view _text, LineColumn const& _input)
 {
 	if (_input.line < 0)
 		return nullopt;
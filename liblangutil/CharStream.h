@@ -51,11 +51,18 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
+namespace solidity::util
+{
+class MappedFile;
+}
+
 namespace solidity::langutil
 {
 
@@ -72,18 +79,22 @@ class CharStream
 public:
 	CharStream() = default;
 	CharStream(std::string _source, std::string _name):
-		m_source(std::move(_source)), m_name(std::move(_name)) {}
-	CharStream(std::string _source, std::string _name, bool _importedFromAST):
-		m_source(std::move(_source)),
-		m_name(std::move(_name)),
-		m_importedFromAST(_importedFromAST)
-	{ }
+		CharStream(std::move(_source), std::move(_name), false) {}
+	CharStream(std::string _source, std::string _name, bool _importedFromAST);
+	/// Creates a stream over the contents of a mapped file, which stays mapped as long as
+	/// the stream or a copy of it exists.
+	CharStream(std::shared_ptr<util::MappedFile const> _file, std::string _name);
 
 	size_t position() const { return m_position; }
 	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
 	bool isImportedFromAST() const { return m_importedFromAST; }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	/// @returns the character @a _charsForward characters ahead or zero past the end of the input.
+	/// The source may be a mapped file, which is not followed by a terminating zero.
+	char get(size_t _charsForward = 0) const
+	{
+		return isPastEndOfInput(_charsForward) ? 0 : m_source[m_position + _charsForward];
+	}
 	char advanceAndGet(size_t _chars = 1);
 	/// Sets scanner position to @ _amount characters backwards in source text.
 	/// @returns The character of the current location after update is returned.
@@ -95,7 +106,7 @@ public:
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	std::string_view source() const noexcept { return m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
 	size_t size() const { return m_source.size(); }
@@ -112,7 +123,7 @@ public:
 	std::optional<int> translateLineColumnToPosition(LineColumn const& _lineColumn) const;
 
 	/// Translates a line:column to the absolute position for the given input text.
-	static std::optional<int> translateLineColumnToPosition(std::string const& _text, LineColumn const& _input);
+	static std::optional<int> translateLineColumnToPosition(std::string_view _text, LineColumn const& _input);
 
 	/// Tests whether or not given octet sequence is present at the current position in stream.
 	/// @returns true if the sequence could be found, false otherwise.
@@ -139,10 +150,13 @@ public:
 		return singleLineSnippet(m_source, _location);
 	}
 
-	static std::string singleLineSnippet(std::string const& _sourceCode, SourceLocation const& _location);
+	static std::string singleLineSnippet(std::string_view _sourceCode, SourceLocation const& _location);
 
 private:
-	std::string m_source;
+	/// Owns the memory m_source refers to, either a string or a mapped file. It is shared,
+	/// so copies of the stream refer to the same memory.
+	std::shared_ptr<void const> m_storage;
+	std::string_view m_source;
 	std::string m_name;
 	bool m_importedFromAST{false};
 	size_t m_position{0};
@@ -0,0 +1,242 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <liblangutil/CharacterSearch.h>
+
+#include <liblangutil/Common.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOLIDITY_CHARACTER_SEARCH_SSE2 1
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+using namespace std;
+
+namespace solidity::langutil
+{
+
+namespace
+{
+
+bool isLineTerminatorCandidate(char _c)
+{
+	return ('\n' <= _c && _c <= '\r') || _c == '\xc2' || _c == '\xe2';
+}
+
+#ifdef SOLIDITY_CHARACTER_SEARCH_SSE2
+
+unsigned countTrailingZeros(unsigned _value)
+{
+#ifdef _MSC_VER
+	unsigned long index = 0;
+	_BitScanForward(&index, _value);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctz(_value));
+#endif
+}
+
+/// @returns a mask in which the bytes equal to @a _c are set.
+__m128i equal(__m128i _chunk, char _c)
+{
+	return _mm_cmpeq_epi8(_chunk, _mm_set1_epi8(_c));
+}
+
+/// @returns a mask in which the bytes in the range [@a _min, @a _max] are set.
+__m128i inRange(__m128i _chunk, char _min, char _max)
+{
+	// Unsigned comparison via minimum: the offset is in range iff it does not exceed the width.
+	__m128i offset = _mm_sub_epi8(_chunk, _mm_set1_epi8(_min));
+	__m128i width = _mm_set1_epi8(static_cast<char>(_max - _min));
+	return _mm_cmpeq_epi8(_mm_min_epu8(offset, width), offset);
+}
+
+/// @returns a mask in which the ASCII letters are set.
+__m128i letter(__m128i _chunk)
+{
+	// Setting bit 5 maps upper case letters to lower case ones and no other byte to a letter.
+	return inRange(_mm_or_si128(_chunk, _mm_set1_epi8(0x20)), 'a', 'z');
+}
+
+__m128i invert(__m128i _mask)
+{
+	return _mm_xor_si128(_mask, _mm_set1_epi8(-1));
+}
+
+__m128i lineTerminatorCandidate(__m128i _chunk)
+{
+	return _mm_or_si128(inRange(_chunk, '\n', '\r'), _mm_or_si128(equal(_chunk, '\xc2'), equal(_chunk, '\xe2')));
+}
+
+#endif
+
+/// @returns the position of the first character in @a _text at or after @a _start that
+/// @a _matcher accepts or the size of @a _text if there is none. The matcher is called with
+/// single characters and, if SSE2 is available, with chunks of 16 characters, for which
+/// it has to return a mask in which the bytes of the accepted characters are set.
+template<typename Matcher>
+size_t findFirst(string_view _text, size_t _start, Matcher const& _matcher)
+{
+	size_t position = _start;
+#ifdef SOLIDITY_CHARACTER_SEARCH_SSE2
+	for (; position + 16 <= _text.size(); position += 16)
+	{
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_text.data() + position));
+		if (unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_matcher(chunk))))
+			return position + countTrailingZeros(mask);
+	}
+#endif
+	for (; position < _text.size(); ++position)
+		if (_matcher(_text[position]))
+			return position;
+	return _text.size();
+}
+
+struct NonWhiteSpace
+{
+	bool operator()(char _c) const { return !isWhiteSpace(_c); }
+#ifdef SOLIDITY_CHARACTER_SEARCH_SSE2
+	__m128i operator()(__m128i _chunk) const
+	{
+		return invert(_mm_or_si128(
+			_mm_or_si128(equal(_chunk, ' '), equal(_chunk, '\t')),
+			_mm_or_si128(equal(_chunk, '\n'), equal(_chunk, '\r'))
+		));
+	}
+#endif
+};
+
+struct NonIdentifierPart
+{
+	bool allowDot;
+
+	bool operator()(char _c) const { return !isIdentifierPart(_c) && !(allowDot && _c == '.'); }
+#ifdef SOLIDITY_CHARACTER_SEARCH_SSE2
+	__m128i operator()(__m128i _chunk) const
+	{
+		__m128i part = _mm_or_si128(
+			_mm_or_si128(letter(_chunk), inRange(_chunk, '0', '9')),
+			_mm_or_si128(equal(_chunk, '_'), equal(_chunk, '$'))
+		);
+		if (allowDot)
+			part = _mm_or_si128(part, equal(_chunk, '.'));
+		return invert(part);
+	}
+#endif
+};
+
+struct NonHexDigit
+{
+	bool operator()(char _c) const { return !isHexDigit(_c); }
+#ifdef SOLIDITY_CHARACTER_SEARCH_SSE2
+	__m128i operator()(__m128i _chunk) const
+	{
+		return invert(_mm_or_si128(
+			inRange(_chunk, '0', '9'),
+			inRange(_mm_or_si128(_chunk, _mm_set1_epi8(0x20)), 'a', 'f')
+		));
+	}
+#endif
+};
+
+struct LineTerminatorCandidate
+{
+	bool operator()(char _c) const { return isLineTerminatorCandidate(_c); }
+#ifdef SOLIDITY_CHARACTER_SEARCH_SSE2
+	__m128i operator()(__m128i _chunk) const { return lineTerminatorCandidate(_chunk); }
+#endif
+};
+
+struct StringLiteralSpecial
+{
+	char quote;
+	bool unicode;
+
+	bool operator()(char _c) const
+	{
+		return
+			_c == quote ||
+			_c == '\\' ||
+			isLineTerminatorCandidate(_c) ||
+			(!unicode && (static_cast<unsigned char>(_c) <= 0x1f || static_cast<unsigned char>(_c) >= 0x7f));
+	}
+#ifdef SOLIDITY_CHARACTER_SEARCH_SSE2
+	__m128i operator()(__m128i _chunk) const
+	{
+		__m128i special = _mm_or_si128(
+			_mm_or_si128(equal(_chunk, quote), equal(_chunk, '\\')),
+			lineTerminatorCandidate(_chunk)
+		);
+		if (!unicode)
+			// Signed comparison, so that this also matches the bytes from 0x80 on.
+			special = _mm_or_si128(
+				special,
+				_mm_or_si128(_mm_cmplt_epi8(_chunk, _mm_set1_epi8(0x20)), equal(_chunk, '\x7f'))
+			);
+		return special;
+	}
+#endif
+};
+
+struct CommentLineSpecial
+{
+	bool operator()(char _c) const { return _c == '\n' || _c == '\r' || _c == '*'; }
+#ifdef SOLIDITY_CHARACTER_SEARCH_SSE2
+	__m128i operator()(__m128i _chunk) const
+	{
+		return _mm_or_si128(_mm_or_si128(equal(_chunk, '\n'), equal(_chunk, '\r')), equal(_chunk, '*'));
+	}
+#endif
+};
+
+}
+
+size_t findNonWhiteSpace(string_view _text, size_t _start)
+{
+	return findFirst(_text, _start, NonWhiteSpace{});
+}
+
+size_t findNonIdentifierPart(string_view _text, size_t _start, bool _allowDot)
+{
+	return findFirst(_text, _start, NonIdentifierPart{_allowDot});
+}
+
+size_t findNonHexDigit(string_view _text, size_t _start)
+{
+	return findFirst(_text, _start, NonHexDigit{});
+}
+
+size_t findLineTerminatorCandidate(string_view _text, size_t _start)
+{
+	return findFirst(_text, _start, LineTerminatorCandidate{});
+}
+
+size_t findStringLiteralSpecial(string_view _text, size_t _start, char _quote, bool _unicode)
+{
+	return findFirst(_text, _start, StringLiteralSpecial{_quote, _unicode});
+}
+
+size_t findCommentLineSpecial(string_view _text, size_t _start)
+{
+	return findFirst(_text, _start, CommentLineSpecial{});
+}
+
+}
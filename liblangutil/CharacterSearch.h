@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Searches for the end of runs of characters of the classes the scanner skips or copies in
+ * bulk. On x86 they compare 16 bytes at a time using SSE2, elsewhere they fall back to a
+ * loop over single characters. Both variants return the same results.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace solidity::langutil
+{
+
+/// @returns the position of the first character in @a _text at or after @a _start that is not
+/// white space (see isWhiteSpace()) or the size of @a _text if there is none.
+size_t findNonWhiteSpace(std::string_view _text, size_t _start);
+
+/// @returns the position of the first character in @a _text at or after @a _start that is not
+/// part of an identifier (see isIdentifierPart()), additionally accepting '.' if @a _allowDot
+/// is true, or the size of @a _text if there is none.
+size_t findNonIdentifierPart(std::string_view _text, size_t _start, bool _allowDot);
+
+/// @returns the position of the first character in @a _text at or after @a _start that is not
+/// a hexadecimal digit or the size of @a _text if there is none.
+size_t findNonHexDigit(std::string_view _text, size_t _start);
+
+/// @returns the position of the first character in @a _text at or after @a _start that may
+/// start a line terminator, i.e. is one of '\n', '\v', '\f' and '\r' or is the first byte
+/// of NEL, LS or PS in UTF-8, or the size of @a _text if there is none.
+size_t findLineTerminatorCandidate(std::string_view _text, size_t _start);
+
+/// @returns the position of the first character in @a _text at or after @a _start that cannot
+/// be copied verbatim into the value of a string literal delimited by @a _quote, or the size
+/// of @a _text if there is none. These are the quote, the backslash and characters that may
+/// start a line terminator. For a non-unicode literal, also all characters that are not
+/// printable ASCII.
+size_t findStringLiteralSpecial(std::string_view _text, size_t _start, char _quote, bool _unicode);
+
+/// @returns the position of the first character in @a _text at or after @a _start that may
+/// end a line or a multi-line comment, i.e. is one of '\n', '\r' and '*', or the size of
+/// @a _text if there is none.
+size_t findCommentLineSpecial(std::string_view _text, size_t _start);
+
+}
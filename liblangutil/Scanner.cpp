@@ -50,6 +50,7 @@
  * Solidity scanner.
  */
 
+#include <liblangutil/CharacterSearch.h>
 #include <liblangutil/Common.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/Scanner.h>
@@ -249,8 +250,13 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
+	if (isWhiteSpace(m_char))
+	{
+		// m_char is consumed on its own, since it is not always the character at the
+		// current position (see skipMultiLineComment()).
 		advance();
+		advanceTo(findNonWhiteSpace(m_source.source(), sourcePos()));
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -284,11 +290,16 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 	};
 
 	size_t endPosition = _stream.position();
-	_stream.setPosition(_startPosition);
+	string_view const source = _stream.source().substr(0, endPosition);
 
 	int directionOverrideDepth = 0;
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	// All of the sequences start with the same byte, so only its occurrences have to be checked.
+	for (
+		size_t currentPos = source.find('\xE2', _startPosition);
+		currentPos < endPosition;
+		currentPos = source.find('\xE2', currentPos + 1)
+	)
 	{
 		_stream.setPosition(currentPos);
 
@@ -313,8 +324,11 @@ Token Scanner::skipSingleLineComment()
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
 	while (!isUnicodeLinebreak())
+	{
 		if (!advance())
 			break;
+		advanceTo(findLineTerminatorCandidate(m_source.source(), sourcePos()));
+	}
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -384,6 +398,16 @@ size_t Scanner::scanSingleLineDocComment()
 			break;
 		addCommentLiteralChar(m_char);
 		advance();
+
+		// Copy the characters up to the next possible line terminator at once.
+		size_t const runEnd = findLineTerminatorCandidate(m_source.source(), sourcePos());
+		if (runEnd != sourcePos())
+		{
+			m_skippedComments[NextNext].literal.append(m_source.source().substr(sourcePos(), runEnd - sourcePos()));
+			// Same end as after copying them one by one, in case the input ends here.
+			endPosition = runEnd - 1;
+			advanceTo(runEnd);
+		}
 	}
 	literal.complete();
 	return endPosition;
@@ -392,26 +416,24 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source.position();
-	while (!isSourcePastEndOfInput())
+	size_t const terminatorPosition = m_source.source().find("*/", startPosition);
+	if (terminatorPosition == string_view::npos)
 	{
-		char prevChar = m_char;
-		advance();
+		advanceTo(m_source.size());
+		// Unterminated multi-line comment.
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+	// We have reached the end of the multi-line comment, we
+	// consume the '/' and insert a whitespace. This way all
+	// multi-line comments are treated as whitespace.
+	advanceTo(terminatorPosition + 1);
+	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+		return setError(unicodeDirectionError);
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
-	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -461,6 +483,11 @@ Token Scanner::scanMultiLineDocComment()
 		addCommentLiteralChar(m_char);
 		charsAdded = true;
 		advance();
+
+		// Copy the characters up to the next line end or possible comment terminator at once.
+		size_t const runEnd = findCommentLineSpecial(m_source.source(), sourcePos());
+		m_skippedComments[NextNext].literal.append(m_source.source().substr(sourcePos(), runEnd - sourcePos()));
+		advanceTo(runEnd);
 	}
 	literal.complete();
 	if (!endFound)
@@ -851,6 +878,11 @@ Token Scanner::scanString(bool const _isUnicode)
 				return setError(ScannerError::UnicodeCharacterInNonUnicodeString);
 			}
 			addLiteralChar(c);
+
+			// Copy the characters that need no further checks at once.
+			size_t const runEnd = findStringLiteralSpecial(m_source.source(), sourcePos(), quote, _isUnicode);
+			m_tokens[NextNext].literal.append(m_source.source().substr(sourcePos(), runEnd - sourcePos()));
+			advanceTo(runEnd);
 		}
 	}
 	if (m_char != quote)
@@ -876,6 +908,23 @@ Token Scanner::scanHexString()
 	bool allowUnderscore = false;
 	while (m_char != quote && !isSourcePastEndOfInput())
 	{
+		// Decode all complete pairs of a run of hex digits at once.
+		string_view const source = m_source.source();
+		size_t const runStart = sourcePos();
+		size_t const pairsEnd = runStart + (findNonHexDigit(source, runStart) - runStart) / 2 * 2;
+		if (pairsEnd != runStart)
+		{
+			// The digits are known to be valid, which allows to convert them without branches.
+			auto digitValue = [](char _digit) { return (_digit & 0xf) + 9 * ((_digit >> 6) & 1); };
+			string& value = m_tokens[NextNext].literal;
+			value.reserve(value.size() + (pairsEnd - runStart) / 2);
+			for (size_t position = runStart; position < pairsEnd; position += 2)
+				value.push_back(static_cast<char>(digitValue(source[position]) * 16 + digitValue(source[position + 1])));
+			advanceTo(pairsEnd);
+			allowUnderscore = true;
+			continue;
+		}
+
 		char c = m_char;
 
 		if (scanHexByte(c))
@@ -1017,8 +1066,9 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	addLiteralCharAndAdvance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	size_t const end = findNonIdentifierPart(m_source.source(), sourcePos(), m_kind == ScannerKind::Yul);
+	m_tokens[NextNext].literal.append(m_source.source().substr(sourcePos(), end - sourcePos()));
+	advanceTo(end);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
@@ -203,6 +203,8 @@ private:
 	///@}
 
 	bool advance() { m_char = m_source.advanceAndGet(); return !m_source.isPastEndOfInput(); }
+	/// Moves forward to @a _position, which was found by one of the bulk searches of CharacterSearch.h.
+	void advanceTo(size_t _position) { m_char = m_source.setPosition(_position); }
 	void rollback(size_t _amount) { m_char = m_source.rollback(_amount); }
 	/// Rolls back to the start of the current token and re-runs the scanner.
 	void rescan();
@@ -41,14 +41,18 @@ CHCSmtLib2Interface::CHCSmtLib2Interface(
 	map<h256, string> const& _queryResponses,
 	ReadCallback::Callback _smtCallback,
 	SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	shared_ptr<SMTQueryCache const> _queryCache
 ):
 	CHCSolverInterface(_queryTimeout),
 	m_smtlib2(make_unique<SMTLib2Interface>(_queryResponses, _smtCallback, m_queryTimeout)),
 	m_queryResponses(std::move(_queryResponses)),
 	m_smtCallback(_smtCallback),
-	m_enabledSolvers(_enabledSolvers)
+	m_enabledSolvers(_enabledSolvers),
+	m_queryCache(std::move(_queryCache))
 {
+	if (m_queryCache)
+		m_cachedSolver = SMTLib2Interface::callbackSolver(m_enabledSolvers.eld ? "eld" : "smtlib2", m_smtCallback);
 	reset();
 }
 
@@ -82,32 +86,35 @@ void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 
 void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& /*_name*/)
 {
-	write(
-		"(assert\n(forall " + forall() + "\n" +
-		m_smtlib2->toSExpr(_expr) +
-		"))\n\n"
-	);
+	m_accumulatedOutput += "(assert\n(forall ";
+	forall(m_accumulatedOutput);
+	m_accumulatedOutput += '\n';
+	m_smtlib2->toSExpr(_expr, m_accumulatedOutput);
+	m_accumulatedOutput += "))\n\n\n";
 }
 
 tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expression const& _block)
 {
-	string accumulated{};
-	swap(m_accumulatedOutput, accumulated);
 	solAssert(m_smtlib2, "");
-	writeHeader();
+	// The header and the user sorts precede the accumulated rules, so the
+	// query is assembled once in a separate buffer instead of repeatedly
+	// copying the accumulated output.
+	string header = this->header();
 	for (auto const& decl: m_smtlib2->userSorts() | ranges::views::values)
-		write(decl);
-	m_accumulatedOutput += accumulated;
-
-	string queryRule = "(assert\n(forall " + forall() + "\n" +
-		"(=> " + _block.name + " false)"
-		"))";
-	string response = querySolver(
-		m_accumulatedOutput +
-		queryRule +
-		"\n(check-sat)"
-	);
-	swap(m_accumulatedOutput, accumulated);
+	{
+		header += decl;
+		header += '\n';
+	}
+	string queryRule = "(assert\n(forall ";
+	forall(queryRule);
+	queryRule += "\n(=> " + _block.name + " false)))\n(check-sat)";
+
+	string query;
+	query.reserve(header.size() + m_accumulatedOutput.size() + queryRule.size());
+	query += header;
+	query += m_accumulatedOutput;
+	query += queryRule;
+	string response = querySolver(query);
 
 	CheckResult result;
 	// TODO proper parsing
@@ -151,24 +158,31 @@ string CHCSmtLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 	return ssort;
 }
 
-void CHCSmtLib2Interface::writeHeader()
+string CHCSmtLib2Interface::header() const
 {
+	string header;
 	if (m_queryTimeout)
-		write("(set-option :timeout " + to_string(*m_queryTimeout) + ")");
-	write("(set-logic HORN)\n");
+		header += "(set-option :timeout " + to_string(*m_queryTimeout) + ")\n";
+	header += "(set-logic HORN)\n\n";
+	return header;
 }
 
-string CHCSmtLib2Interface::forall()
+void CHCSmtLib2Interface::forall(string& _output)
 {
-	string vars("(");
+	_output += '(';
 	for (auto const& [name, sort]: m_smtlib2->variables())
 	{
 		solAssert(sort, "");
 		if (sort->kind != Kind::Function)
-			vars += " (" + name + " " + toSmtLibSort(*sort) + ")";
+		{
+			_output += " (";
+			_output += name;
+			_output += ' ';
+			_output += toSmtLibSort(*sort);
+			_output += ')';
+		}
 	}
-	vars += ")";
-	return vars;
+	_output += ')';
 }
 
 void CHCSmtLib2Interface::declareFunction(string const& _name, SortPointer const& _sort)
@@ -197,21 +211,31 @@ void CHCSmtLib2Interface::declareFunction(string const& _name, SortPointer const
 
 void CHCSmtLib2Interface::write(string _data)
 {
-	m_accumulatedOutput += std::move(_data) + "\n";
+	m_accumulatedOutput += _data;
+	m_accumulatedOutput += '\n';
 }
 
 string CHCSmtLib2Interface::querySolver(string const& _input)
 {
+	m_lastQuerySize = _input.size();
 	util::h256 inputHash = util::keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
 
 	smtAssert(m_enabledSolvers.smtlib2 || m_enabledSolvers.eld);
+	if (m_queryCache && m_cachedSolver)
+		if (auto response = m_queryCache->lookup(*m_cachedSolver, _input))
+			return *response;
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
-			return result.responseOrErrorMessage;
+		{
+			string const& response = result.responseOrErrorMessage;
+			if (m_queryCache && m_cachedSolver && (boost::starts_with(response, "sat") || boost::starts_with(response, "unsat")))
+				m_queryCache->store(*m_cachedSolver, _input, response);
+			return response;
+		}
 	}
 
 	m_unhandledQueries.push_back(_input);
@@ -36,7 +36,8 @@ public:
 		std::map<util::h256, std::string> const& _queryResponses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<SMTQueryCache const> _queryCache = nullptr
 	);
 
 	void reset();
@@ -55,18 +56,22 @@ public:
 
 	SMTLib2Interface* smtlib2Interface() const { return m_smtlib2.get(); }
 
+	/// @returns the size in bytes of the last query sent to the solver.
+	size_t lastQuerySize() const { return m_lastQuerySize; }
+
 private:
 	std::string toSmtLibSort(Sort const& _sort);
 	std::string toSmtLibSort(std::vector<SortPointer> const& _sort);
 
-	void writeHeader();
-	std::string forall();
+	std::string header() const;
+	/// Appends the list of the bound variables of a rule to @a _output.
+	void forall(std::string& _output);
 
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
 	void write(std::string _data);
 
-	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
+	/// Communicates with the solver via the query cache or the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
 
 	/// Used to access toSmtLibSort, SExpr, and handle variables.
@@ -77,9 +82,13 @@ private:
 
 	std::map<util::h256, std::string> const& m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
+	size_t m_lastQuerySize = 0;
 
 	frontend::ReadCallback::Callback m_smtCallback;
 	SMTSolverChoice m_enabledSolvers;
+	std::shared_ptr<SMTQueryCache const> m_queryCache;
+	/// Identity of the solver in the query cache. Answers are only cached if it is known.
+	std::optional<std::string> m_cachedSolver;
 
 	std::map<Sort const*, std::string> m_sortNames;
 };
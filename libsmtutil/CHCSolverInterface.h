@@ -59,6 +59,9 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// @returns why the last query returned UNKNOWN, or an empty string if the solver did not say.
+	virtual std::string unknownReason() const { return {}; }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
@@ -0,0 +1,180 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/ConeOfInfluence.h>
+
+#include <cctype>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <string>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+
+namespace
+{
+
+/// @returns the conjuncts of @a _expr, looking through nested conjunctions.
+vector<Expression const*> conjuncts(Expression const& _expr)
+{
+	vector<Expression const*> result;
+	vector<Expression const*> toVisit{&_expr};
+	while (!toVisit.empty())
+	{
+		Expression const* expr = toVisit.back();
+		toVisit.pop_back();
+		if (expr->name == "and" && expr->sort->kind == Kind::Bool)
+			// Reversed, so that the conjuncts keep their order.
+			for (auto argument = expr->arguments.rbegin(); argument != expr->arguments.rend(); ++argument)
+				toVisit.push_back(&*argument);
+		else
+			result.push_back(expr);
+	}
+	return result;
+}
+
+bool isConstant(string const& _name)
+{
+	return
+		_name.empty() ||
+		isdigit(static_cast<unsigned char>(_name.front())) ||
+		_name.front() == '-' ||
+		_name.front() == '#' ||
+		_name == "true" ||
+		_name == "false";
+}
+
+/// Union-find over the variables of a query.
+class VariableClasses
+{
+public:
+	/// Adds the variables of @a _expr to a common class.
+	/// @returns one of these variables, if there is any, and sets @a _nodes to the number of nodes of @a _expr.
+	optional<size_t> addExpression(Expression const& _expr, size_t& _nodes)
+	{
+		vector<size_t> variables;
+		vector<Expression const*> toVisit{&_expr};
+		_nodes = 0;
+		while (!toVisit.empty())
+		{
+			Expression const* expr = toVisit.back();
+			toVisit.pop_back();
+			++_nodes;
+			if (expr->arguments.empty())
+			{
+				if (!isConstant(expr->name))
+					variables.push_back(variable(expr->name));
+			}
+			else
+				for (auto const& argument: expr->arguments)
+					toVisit.push_back(&argument);
+		}
+		if (variables.empty())
+			return nullopt;
+		for (size_t i = 1; i < variables.size(); ++i)
+			unite(variables.front(), variables[i]);
+		return variables.front();
+	}
+
+	size_t find(size_t _variable)
+	{
+		while (m_parents[_variable] != _variable)
+			_variable = m_parents[_variable] = m_parents[m_parents[_variable]];
+		return _variable;
+	}
+
+private:
+	size_t variable(string const& _name)
+	{
+		auto [it, inserted] = m_indices.emplace(_name, m_parents.size());
+		if (inserted)
+			m_parents.push_back(it->second);
+		return it->second;
+	}
+
+	void unite(size_t _a, size_t _b)
+	{
+		m_parents[find(_a)] = find(_b);
+	}
+
+	map<string, size_t> m_indices;
+	vector<size_t> m_parents;
+};
+
+}
+
+SlicingStatistics& SlicingStatistics::operator+=(SlicingStatistics const& _other)
+{
+	queries += _other.queries;
+	conjuncts += _other.conjuncts;
+	keptConjuncts += _other.keptConjuncts;
+	nodes += _other.nodes;
+	keptNodes += _other.keptNodes;
+	return *this;
+}
+
+Expression smtutil::coneOfInfluence(
+	Expression const& _conjunction,
+	vector<Expression> const& _roots,
+	SlicingStatistics& _statistics
+)
+{
+	VariableClasses classes;
+	vector<Expression const*> parts = conjuncts(_conjunction);
+	vector<optional<size_t>> variables;
+	vector<size_t> nodes(parts.size());
+	for (size_t i = 0; i < parts.size(); ++i)
+		variables.emplace_back(classes.addExpression(*parts[i], nodes[i]));
+
+	vector<optional<size_t>> rootVariables;
+	for (Expression const& root: _roots)
+	{
+		size_t rootNodes = 0;
+		rootVariables.emplace_back(classes.addExpression(root, rootNodes));
+	}
+	set<size_t> rootClasses;
+	for (auto const& variable: rootVariables)
+		if (variable)
+			rootClasses.insert(classes.find(*variable));
+
+	vector<Expression const*> kept;
+	size_t keptNodes = 0;
+	for (size_t i = 0; i < parts.size(); ++i)
+		// All variables of a conjunct are in the same class.
+		if (!variables[i] || rootClasses.count(classes.find(*variables[i])))
+		{
+			kept.push_back(parts[i]);
+			keptNodes += nodes[i];
+		}
+
+	++_statistics.queries;
+	_statistics.conjuncts += parts.size();
+	_statistics.keptConjuncts += kept.size();
+	_statistics.nodes += accumulate(nodes.begin(), nodes.end(), size_t(0));
+	_statistics.keptNodes += keptNodes;
+
+	if (kept.empty())
+		return Expression(true);
+	Expression result = *kept.back();
+	for (auto part = next(kept.rbegin()); part != kept.rend(); ++part)
+		result = **part && std::move(result);
+	return result;
+}
@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/**
+ * Cone-of-influence slicing of conjunctions.
+ */
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/// Sizes of the queries before and after slicing.
+struct SlicingStatistics
+{
+	/// Number of sliced queries.
+	size_t queries = 0;
+	/// Number of conjuncts of the queries before slicing.
+	size_t conjuncts = 0;
+	/// Number of conjuncts that were kept.
+	size_t keptConjuncts = 0;
+	/// Number of expression nodes of the queries before slicing.
+	size_t nodes = 0;
+	/// Number of expression nodes that were kept.
+	size_t keptNodes = 0;
+
+	SlicingStatistics& operator+=(SlicingStatistics const& _other);
+};
+
+/// @returns the conjunction of the conjuncts of @a _conjunction that are in the cone of influence
+/// of @a _roots, that is, the conjuncts that transitively share a variable with one of @a _roots,
+/// and the conjuncts that do not contain any variable.
+/// The result is implied by @a _conjunction, so if it is unsatisfiable, so is @a _conjunction,
+/// but it may be satisfiable even if @a _conjunction is not.
+/// Adds the sizes of @a _conjunction and of the result to @a _statistics.
+Expression coneOfInfluence(
+	Expression const& _conjunction,
+	std::vector<Expression> const& _roots,
+	SlicingStatistics& _statistics
+);
+
+}
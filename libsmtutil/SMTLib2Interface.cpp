@@ -42,12 +42,16 @@ using namespace solidity::smtutil;
 SMTLib2Interface::SMTLib2Interface(
 	map<h256, string> _queryResponses,
 	ReadCallback::Callback _smtCallback,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	shared_ptr<SMTQueryCache const> _queryCache
 ):
 	SolverInterface(_queryTimeout),
 	m_queryResponses(std::move(_queryResponses)),
-	m_smtCallback(std::move(_smtCallback))
+	m_smtCallback(std::move(_smtCallback)),
+	m_queryCache(std::move(_queryCache))
 {
+	if (m_queryCache)
+		m_cachedSolver = callbackSolver("smtlib2", m_smtCallback);
 	reset();
 }
 
@@ -111,15 +115,30 @@ void SMTLib2Interface::declareFunction(string const& _name, SortPointer const& _
 
 void SMTLib2Interface::addAssertion(Expression const& _expr)
 {
-	write("(assert " + toSExpr(_expr) + ")");
+	// Sorts used by the expression may be declared while it is printed,
+	// so it cannot be printed directly into the accumulated output.
+	string assertion = "(assert ";
+	toSExpr(_expr, assertion);
+	assertion += ')';
+	write(std::move(assertion));
 }
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string command = checkSatAndGetValuesCommand(_expressionsToEvaluate);
+	string query;
+	size_t querySize = command.size() + m_accumulatedOutput.size() - 1;
+	for (string const& output: m_accumulatedOutput)
+		querySize += output.size();
+	query.reserve(querySize);
+	for (size_t i = 0; i < m_accumulatedOutput.size(); ++i)
+	{
+		if (i > 0)
+			query += '\n';
+		query += m_accumulatedOutput[i];
+	}
+	query += command;
+	string response = querySolver(query);
 
 	CheckResult result;
 	// TODO proper parsing
@@ -139,21 +158,38 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 }
 
 string SMTLib2Interface::toSExpr(Expression const& _expr)
+{
+	string sexpr;
+	toSExpr(_expr, sexpr);
+	return sexpr;
+}
+
+void SMTLib2Interface::toSExpr(Expression const& _expr, string& _output)
 {
 	if (_expr.arguments.empty())
-		return _expr.name;
+	{
+		_output += _expr.name;
+		return;
+	}
 
-	std::string sexpr = "(";
 	if (_expr.name == "int2bv")
 	{
 		size_t size = std::stoul(_expr.arguments[1].name);
 		auto arg = toSExpr(_expr.arguments.front());
 		auto int2bv = "(_ int2bv " + to_string(size) + ")";
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
-		sexpr += string("ite ") +
-			"(>= " + arg + " 0) " +
-			"(" + int2bv + " " + arg + ") " +
-			"(bvneg (" + int2bv + " (- " + arg + ")))";
+		_output += "(ite (>= ";
+		_output += arg;
+		_output += " 0) (";
+		_output += int2bv;
+		_output += ' ';
+		_output += arg;
+		_output += ") (bvneg (";
+		_output += int2bv;
+		_output += " (- ";
+		_output += arg;
+		_output += "))))";
+		return;
 	}
 	else if (_expr.name == "bv2int")
 	{
@@ -161,31 +197,39 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		smtAssert(intSort, "");
 
 		auto arg = toSExpr(_expr.arguments.front());
-		auto nat = "(bv2nat " + arg + ")";
-
 		if (!intSort->isSigned)
-			return nat;
+		{
+			_output += "(bv2nat ";
+			_output += arg;
+			_output += ')';
+			return;
+		}
 
 		auto bvSort = dynamic_pointer_cast<BitVectorSort>(_expr.arguments.front().sort);
 		smtAssert(bvSort, "");
-		auto size = to_string(bvSort->size);
 		auto pos = to_string(bvSort->size - 1);
 
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
-		sexpr += string("ite ") +
-			"(= ((_ extract " + pos + " " + pos + ")" + arg + ") #b0) " +
-			nat + " " +
-			"(- (bv2nat (bvneg " + arg + ")))";
+		_output += "(ite (= ((_ extract " + pos + " " + pos + ")";
+		_output += arg;
+		_output += ") #b0) (bv2nat ";
+		_output += arg;
+		_output += ") (- (bv2nat (bvneg ";
+		_output += arg;
+		_output += "))))";
+		return;
 	}
-	else if (_expr.name == "const_array")
+
+	_output += '(';
+	if (_expr.name == "const_array")
 	{
 		smtAssert(_expr.arguments.size() == 2, "");
 		auto sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments.at(0).sort);
 		smtAssert(sortSort, "");
 		auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		smtAssert(arraySort, "");
-		sexpr += "(as const " + toSmtLibSort(*arraySort) + ") ";
-		sexpr += toSExpr(_expr.arguments.at(1));
+		_output += "(as const " + toSmtLibSort(*arraySort) + ") ";
+		toSExpr(_expr.arguments.at(1), _output);
 	}
 	else if (_expr.name == "tuple_get")
 	{
@@ -193,24 +237,34 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.arguments.at(0).sort);
 		size_t index = std::stoul(_expr.arguments.at(1).name);
 		smtAssert(index < tupleSort->members.size(), "");
-		sexpr += "|" + tupleSort->members.at(index) + "| " + toSExpr(_expr.arguments.at(0));
+		_output += '|';
+		_output += tupleSort->members.at(index);
+		_output += "| ";
+		toSExpr(_expr.arguments.at(0), _output);
 	}
 	else if (_expr.name == "tuple_constructor")
 	{
 		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.sort);
 		smtAssert(tupleSort, "");
-		sexpr += "|" + tupleSort->name + "|";
+		_output += '|';
+		_output += tupleSort->name;
+		_output += '|';
 		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		{
+			_output += ' ';
+			toSExpr(arg, _output);
+		}
 	}
 	else
 	{
-		sexpr += _expr.name;
+		_output += _expr.name;
 		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		{
+			_output += ' ';
+			toSExpr(arg, _output);
+		}
 	}
-	sexpr += ")";
-	return sexpr;
+	_output += ')';
 }
 
 string SMTLib2Interface::toSmtLibSort(Sort const& _sort)
@@ -264,7 +318,8 @@ string SMTLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 void SMTLib2Interface::write(string _data)
 {
 	smtAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.back() += std::move(_data) + "\n";
+	m_accumulatedOutput.back() += _data;
+	m_accumulatedOutput.back() += '\n';
 }
 
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
@@ -280,7 +335,9 @@ string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _
 			auto const& e = _expressionsToEvaluate.at(i);
 			smtAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
 			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
-			command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
+			command += "(assert (= |EVALEXPR_" + to_string(i) + "| ";
+			toSExpr(e, command);
+			command += "))\n";
 		}
 		command += "(check-sat)\n";
 		command += "(get-value (";
@@ -310,15 +367,34 @@ vector<string> SMTLib2Interface::parseValues(string::const_iterator _start, stri
 
 string SMTLib2Interface::querySolver(string const& _input)
 {
+	m_lastQuerySize = _input.size();
 	h256 inputHash = keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	if (m_queryCache && m_cachedSolver)
+		if (auto response = m_queryCache->lookup(*m_cachedSolver, _input))
+			return *response;
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
-			return result.responseOrErrorMessage;
+		{
+			string const& response = result.responseOrErrorMessage;
+			if (m_queryCache && m_cachedSolver && (boost::starts_with(response, "sat\n") || boost::starts_with(response, "unsat\n")))
+				m_queryCache->store(*m_cachedSolver, _input, response);
+			return response;
+		}
 	}
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
 }
+
+optional<string> SMTLib2Interface::callbackSolver(string const& _name, ReadCallback::Callback const& _smtCallback)
+{
+	if (!_smtCallback)
+		return nullopt;
+	auto result = _smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTSolverVersion), "");
+	if (!result.success || result.responseOrErrorMessage.empty())
+		return nullopt;
+	return _name + " " + result.responseOrErrorMessage;
+}
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libsmtutil/SMTQueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 
 #include <libsolidity/interface/ReadFile.h>
@@ -27,6 +28,7 @@
 
 #include <cstdio>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -44,7 +46,8 @@ public:
 	explicit SMTLib2Interface(
 		std::map<util::h256, std::string> _queryResponses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<SMTQueryCache const> _queryCache = nullptr
 	);
 
 	void reset() override;
@@ -61,13 +64,23 @@ public:
 
 	// Used by CHCSmtLib2Interface
 	std::string toSExpr(Expression const& _expr);
+	/// Appends the s-expression of @a _expr to @a _output, without building
+	/// separate strings for its subexpressions.
+	void toSExpr(Expression const& _expr, std::string& _output);
 	std::string toSmtLibSort(Sort const& _sort);
 	std::string toSmtLibSort(std::vector<SortPointer> const& _sort);
 
-	std::map<std::string, SortPointer> variables() { return m_variables; }
+	std::map<std::string, SortPointer> const& variables() const { return m_variables; }
+
+	/// @returns the size in bytes of the last query sent to the solver.
+	size_t lastQuerySize() const { return m_lastQuerySize; }
 
 	std::vector<std::pair<std::string, std::string>> const& userSorts() const { return m_userSorts; }
 
+	/// @returns the identity of the solver behind @a _smtCallback in the query cache, which is
+	/// @a _name followed by the version reported by the callback, or nullopt if it reports none.
+	static std::optional<std::string> callbackSolver(std::string const& _name, frontend::ReadCallback::Callback const& _smtCallback);
+
 private:
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
@@ -76,7 +89,7 @@ private:
 	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
-	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
+	/// Communicates with the solver via the query cache or the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
 
 	std::vector<std::string> m_accumulatedOutput;
@@ -90,8 +103,12 @@ private:
 
 	std::map<util::h256, std::string> m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
+	size_t m_lastQuerySize = 0;
 
 	frontend::ReadCallback::Callback m_smtCallback;
+	std::shared_ptr<SMTQueryCache const> m_queryCache;
+	/// Identity of the solver in the query cache. Answers are only cached if it is known.
+	std::optional<std::string> m_cachedSolver;
 };
 
 }
@@ -26,6 +26,11 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -35,27 +40,54 @@ using namespace solidity::smtutil;
 SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
-	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	SMTSolverChoice _enabledSolvers,
+	optional<unsigned> _queryTimeout,
+	Mode _mode,
+	shared_ptr<SMTQueryCache const> _queryCache
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_enabledSolvers(_enabledSolvers),
+	m_mode(_mode),
+	m_queryCache(std::move(_queryCache))
 {
 	if (_enabledSolvers.smtlib2)
-		m_solvers.emplace_back(make_unique<SMTLib2Interface>(std::move(_smtlib2Responses), std::move(_smtCallback), m_queryTimeout));
+	{
+		m_solvers.emplace_back(make_unique<SMTLib2Interface>(std::move(_smtlib2Responses), std::move(_smtCallback), m_queryTimeout, m_queryCache));
+		m_solverNames.emplace_back("smtlib2");
+	}
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
-		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+	{
+		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout, m_queryCache));
+		m_solverNames.emplace_back("z3");
+	}
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
+	{
 		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+		m_solverNames.emplace_back("cvc4");
+	}
 #endif
 }
 
+SMTPortfolio::SolverStatistics& SMTPortfolio::SolverStatistics::operator+=(SolverStatistics const& _other)
+{
+	queries += _other.queries;
+	answers += _other.answers;
+	wins += _other.wins;
+	time += _other.time;
+	queryBytes += _other.queryBytes;
+	largestQueryBytes = max(largestQueryBytes, _other.largestQueryBytes);
+	assertedNodes += _other.assertedNodes;
+	return *this;
+}
+
 void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
 		s->reset();
+	m_declarations.clear();
 }
 
 void SMTPortfolio::push()
@@ -75,12 +107,27 @@ void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort
 	smtAssert(_sort, "");
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
+	m_declarations[_name] = _sort;
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
 {
-	for (auto const& s: m_solvers)
-		s->addAssertion(_expr);
+	size_t nodes = 0;
+	for (vector<Expression const*> toVisit{&_expr}; m_countAssertedNodes && !toVisit.empty();)
+	{
+		Expression const* expr = toVisit.back();
+		toVisit.pop_back();
+		++nodes;
+		for (auto const& argument: expr->arguments)
+			toVisit.push_back(&argument);
+	}
+
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+	{
+		m_solvers[i]->addAssertion(_expr);
+		if (m_countAssertedNodes)
+			m_statistics[m_solverNames[i]].assertedNodes += nodes;
+	}
 }
 
 /*
@@ -112,33 +159,225 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * In Race mode the solvers run concurrently and the first SAT or UNSAT answer is returned
+ * as is, without cross-checking it, while the other solvers are interrupted.
+ * In Parallel mode the solvers run concurrently but the answers are combined as above.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	auto start = chrono::steady_clock::now();
+	vector<Answer> answers(m_solvers.size());
+	optional<size_t> firstAnswer;
+	if (m_mode != Mode::Sequential)
+	{
+		firstAnswer = checkConcurrently(_expressionsToEvaluate, answers);
+		if (!(m_mode == Mode::Race && firstAnswer))
+			for (Answer const& answer: answers)
+				if (answer.error)
+					rethrow_exception(answer.error);
+	}
+
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	if (m_mode == Mode::Race && firstAnswer)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
-		if (solverAnswered(result))
+		lastResult = answers[*firstAnswer].result;
+		finalValues = answers[*firstAnswer].values;
+	}
+	else
+		for (size_t i = 0; i < m_solvers.size(); ++i)
 		{
-			if (!solverAnswered(lastResult))
+			if (m_mode == Mode::Sequential)
+				answers[i] = checkSolver(i, _expressionsToEvaluate);
+			CheckResult result = answers[i].result;
+			if (solverAnswered(result))
 			{
+				if (!solverAnswered(lastResult))
+				{
+					lastResult = result;
+					finalValues = answers[i].values;
+				}
+				else if (lastResult != result)
+				{
+					lastResult = CheckResult::CONFLICTING;
+					break;
+				}
+			}
+			else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
 				lastResult = result;
-				finalValues = std::move(values);
+		}
+
+	recordStatistics(answers, firstAnswer);
+	m_lastQuery.time = chrono::steady_clock::now() - start;
+	return make_pair(lastResult, finalValues);
+}
+
+SMTPortfolio::Answer SMTPortfolio::checkSolver(size_t _index, vector<Expression> const& _expressionsToEvaluate)
+{
+	Answer answer;
+	auto start = chrono::steady_clock::now();
+	tie(answer.result, answer.values) = m_solvers[_index]->check(_expressionsToEvaluate);
+	answer.time = chrono::steady_clock::now() - start;
+	answer.asked = true;
+	if (answer.result == CheckResult::UNKNOWN)
+		answer.unknownReason = m_solvers[_index]->unknownReason();
+	if (auto const* smtlib2 = dynamic_cast<SMTLib2Interface const*>(m_solvers[_index].get()))
+		answer.queryBytes = smtlib2->lastQuerySize();
+	return answer;
+}
+
+optional<size_t> SMTPortfolio::checkConcurrently(
+	vector<Expression> const& _expressionsToEvaluate,
+	vector<Answer>& _answers
+)
+{
+	size_t const noAnswer = m_solvers.size();
+	atomic<size_t> firstAnswer{noAnswer};
+	// Interrupting a solver outside of check can make its next call fail,
+	// so only the solvers that are currently checking are interrupted.
+	mutex checkingMutex;
+	vector<bool> checking(m_solvers.size(), false);
+	auto runSolver = [&](size_t _index)
+	{
+		{
+			lock_guard<mutex> lock(checkingMutex);
+			// A solver that has not started yet does not need to be interrupted.
+			if (m_mode == Mode::Race && firstAnswer != noAnswer)
+				return;
+			checking[_index] = true;
+		}
+		try
+		{
+			_answers[_index] = checkSolver(_index, _expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			_answers[_index].error = current_exception();
+		}
+		lock_guard<mutex> lock(checkingMutex);
+		checking[_index] = false;
+		if (_answers[_index].error || !solverAnswered(_answers[_index].result))
+			return;
+		size_t expected = noAnswer;
+		if (firstAnswer.compare_exchange_strong(expected, _index) && m_mode == Mode::Race)
+			for (size_t i = 0; i < m_solvers.size(); ++i)
+				if (checking[i])
+					m_solvers[i]->interrupt();
+	};
+
+	// The first solver is the SMT-LIB2 interface, if enabled, which has to stay
+	// in this thread since the SMT callback must not be called from other threads.
+	vector<thread> threads;
+	for (size_t i = 1; i < m_solvers.size(); ++i)
+		threads.emplace_back(runSolver, i);
+	if (!m_solvers.empty())
+		runSolver(0);
+	for (auto& t: threads)
+		t.join();
+
+	if (firstAnswer == noAnswer)
+		return nullopt;
+	return firstAnswer.load();
+}
+
+void SMTPortfolio::recordStatistics(vector<Answer> const& _answers, optional<size_t> _firstAnswer)
+{
+	// Queried one after the other, the fastest answer is the one that would have won a race.
+	if (m_mode == Mode::Sequential)
+		for (size_t i = 0; i < _answers.size(); ++i)
+			if (_answers[i].asked && solverAnswered(_answers[i].result))
+				if (!_firstAnswer || _answers[i].time < _answers[*_firstAnswer].time)
+					_firstAnswer = i;
+
+	m_lastQuery = {};
+	if (_firstAnswer)
+		m_lastQuery.solver = m_solverNames[*_firstAnswer];
+	else
+	{
+		set<string> reasons;
+		for (Answer const& answer: _answers)
+			if (!answer.unknownReason.empty() && reasons.insert(answer.unknownReason).second)
+				m_lastQuery.unknownReason += (m_lastQuery.unknownReason.empty() ? "" : ", ") + answer.unknownReason;
+	}
+	for (size_t i = 0; i < _answers.size(); ++i)
+	{
+		if (!_answers[i].asked)
+			continue;
+		m_lastQuery.queryBytes = max(m_lastQuery.queryBytes, _answers[i].queryBytes);
+		SolverStatistics& statistics = m_statistics[m_solverNames[i]];
+		++statistics.queries;
+		if (solverAnswered(_answers[i].result))
+			++statistics.answers;
+		if (_firstAnswer == i)
+			++statistics.wins;
+		statistics.time += _answers[i].time;
+		statistics.queryBytes += _answers[i].queryBytes;
+		statistics.largestQueryBytes = max(statistics.largestQueryBytes, _answers[i].queryBytes);
+	}
+}
+
+vector<SMTPortfolio::ParallelResult> SMTPortfolio::checkInParallel(
+	vector<ParallelQuery> const& _queries,
+	unsigned _threads
+)
+{
+	smtAssert(_threads > 0, "");
+	vector<ParallelResult> results(_queries.size());
+	if (_queries.empty())
+		return results;
+
+	SMTSolverChoice workerSolvers = m_enabledSolvers;
+	workerSolvers.smtlib2 = false;
+
+	// The solvers are created here and not by the threads, since their
+	// constructors may set global solver parameters.
+	vector<unique_ptr<SMTPortfolio>> workers;
+	for (size_t i = 0; i < min<size_t>(_threads, _queries.size()); ++i)
+	{
+		auto worker = make_unique<SMTPortfolio>(map<h256, string>{}, ReadCallback::Callback{}, workerSolvers, m_queryTimeout, m_mode, m_queryCache);
+		worker->setCountAssertedNodes(m_countAssertedNodes);
+		for (auto const& [name, sort]: m_declarations)
+			worker->declareVariable(name, sort);
+		workers.emplace_back(std::move(worker));
+	}
+
+	atomic<size_t> nextQuery{0};
+	auto solveQueries = [&](SMTPortfolio& _worker)
+	{
+		for (size_t i = nextQuery++; i < _queries.size(); i = nextQuery++)
+		{
+			bool pushed = false;
+			try
+			{
+				_worker.push();
+				pushed = true;
+				_worker.addAssertion(_queries[i].assertion);
+				tie(results[i].result, results[i].values) = _worker.check(_queries[i].expressionsToEvaluate);
+				results[i].statistics = _worker.lastQuery();
+				_worker.pop();
 			}
-			else if (lastResult != result)
+			catch (...)
 			{
-				lastResult = CheckResult::CONFLICTING;
-				break;
+				results[i].error = current_exception();
+				if (pushed)
+					_worker.pop();
 			}
 		}
-		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
-			lastResult = result;
-	}
-	return make_pair(lastResult, finalValues);
+	};
+
+	vector<thread> threads;
+	for (size_t i = 1; i < workers.size(); ++i)
+		threads.emplace_back(solveQueries, ref(*workers[i]));
+	solveQueries(*workers.front());
+	for (auto& t: threads)
+		t.join();
+
+	for (auto const& worker: workers)
+		for (auto const& [name, statistics]: worker->statistics())
+			m_statistics[name] += statistics;
+
+	return results;
 }
 
 vector<string> SMTPortfolio::unhandledQueries()
@@ -19,11 +19,15 @@
 #pragma once
 
 
+#include <libsmtutil/SMTQueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
 
+#include <chrono>
+#include <exception>
 #include <map>
+#include <optional>
 #include <vector>
 
 namespace solidity::smtutil
@@ -34,10 +38,76 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * Depending on its mode, the solvers are either queried one after the other
+ * or concurrently, in which case the first definitive answer can be taken
+ * without waiting for the other solvers.
  */
 class SMTPortfolio: public SolverInterface
 {
 public:
+	enum class Mode
+	{
+		/// Queries the solvers one after the other and cross-checks their answers.
+		Sequential,
+		/// Queries the solvers concurrently, takes the first SAT or UNSAT answer
+		/// and interrupts the other solvers.
+		Race,
+		/// Queries the solvers concurrently and cross-checks their answers.
+		Parallel
+	};
+
+	/// Counters of one solver of the portfolio.
+	struct SolverStatistics
+	{
+		/// Number of queries the solver was asked.
+		size_t queries = 0;
+		/// Number of queries the solver answered with SAT or UNSAT.
+		size_t answers = 0;
+		/// Number of queries for which the solver gave the fastest SAT or UNSAT answer.
+		size_t wins = 0;
+		/// Total time spent in the solver.
+		std::chrono::steady_clock::duration time{};
+		/// Total size of the SMT-LIB2 queries sent to the solver, if it is queried via SMT-LIB2.
+		size_t queryBytes = 0;
+		/// Size of the largest of these queries.
+		size_t largestQueryBytes = 0;
+		/// Total number of expression nodes asserted in the solver.
+		size_t assertedNodes = 0;
+
+		SolverStatistics& operator+=(SolverStatistics const& _other);
+	};
+
+	/// The outcome of a single call to check.
+	struct QueryStatistics
+	{
+		/// The solver that gave the fastest SAT or UNSAT answer, or the empty string if none did.
+		std::string solver;
+		/// Size of the query in bytes if it was sent to a solver via SMT-LIB2, and 0 otherwise.
+		size_t queryBytes = 0;
+		/// Time until the answer was known.
+		std::chrono::steady_clock::duration time{};
+		/// If no solver gave a SAT or UNSAT answer, the reasons the solvers gave for their
+		/// UNKNOWN answers, separated by ", ", or the empty string if they did not say.
+		std::string unknownReason;
+	};
+
+	/// An independent query for checkInParallel.
+	struct ParallelQuery
+	{
+		Expression assertion;
+		std::vector<Expression> expressionsToEvaluate;
+	};
+
+	/// The outcome of a ParallelQuery. If checking the query threw an exception,
+	/// it is stored in @a error instead of being propagated.
+	struct ParallelResult
+	{
+		CheckResult result = CheckResult::ERROR;
+		std::vector<std::string> values;
+		std::exception_ptr error;
+		QueryStatistics statistics;
+	};
+
 	/// Noncopyable.
 	SMTPortfolio(SMTPortfolio const&) = delete;
 	SMTPortfolio& operator=(SMTPortfolio const&) = delete;
@@ -46,7 +116,9 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		Mode _mode = Mode::Sequential,
+		std::shared_ptr<SMTQueryCache const> _queryCache = nullptr
 	);
 
 	void reset() override;
@@ -60,12 +132,60 @@ public:
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	/// Checks each of @a _queries on its own, on top of the variables declared since the last
+	/// reset but ignoring the current assertions, using up to @a _threads threads.
+	/// Every thread uses a fresh instance of the enabled solvers. The SMT-LIB2 interface is
+	/// never used since the SMT callback must not be called concurrently.
+	/// @returns the results in the order of @a _queries.
+	std::vector<ParallelResult> checkInParallel(std::vector<ParallelQuery> const& _queries, unsigned _threads);
+
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
+
+	/// Sets whether addAssertion counts the asserted expression nodes, which takes time
+	/// proportional to the size of the assertions. Off by default.
+	void setCountAssertedNodes(bool _count) { m_countAssertedNodes = _count; }
+
+	/// @returns the counters of each solver, keyed by solver name.
+	std::map<std::string, SolverStatistics> const& statistics() const { return m_statistics; }
+	/// @returns the outcome of the last call to check.
+	QueryStatistics const& lastQuery() const { return m_lastQuery; }
 private:
+	struct Answer
+	{
+		CheckResult result = CheckResult::ERROR;
+		std::vector<std::string> values;
+		std::chrono::steady_clock::duration time{};
+		std::exception_ptr error;
+		bool asked = false;
+		size_t queryBytes = 0;
+		std::string unknownReason;
+	};
+
 	static bool solverAnswered(CheckResult result);
 
+	/// Asks the solver at @a _index and measures the time it takes.
+	Answer checkSolver(size_t _index, std::vector<Expression> const& _expressionsToEvaluate);
+	/// Asks all solvers at the same time, the first one in the calling thread.
+	/// @returns the index of the solver that gave the first SAT or UNSAT answer, if any.
+	std::optional<size_t> checkConcurrently(
+		std::vector<Expression> const& _expressionsToEvaluate,
+		std::vector<Answer>& _answers
+	);
+	void recordStatistics(std::vector<Answer> const& _answers, std::optional<size_t> _firstAnswer);
+
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	std::vector<std::string> m_solverNames;
+	SMTSolverChoice m_enabledSolvers;
+	Mode m_mode;
+	std::shared_ptr<SMTQueryCache const> m_queryCache;
+
+	std::map<std::string, SolverStatistics> m_statistics;
+	QueryStatistics m_lastQuery;
+	bool m_countAssertedNodes = false;
+
+	/// Variables declared since the last reset, used to set up the solvers of checkInParallel.
+	std::map<std::string, SortPointer> m_declarations;
 
 	std::vector<Expression> m_assertions;
 };
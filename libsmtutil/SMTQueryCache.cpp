@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/SMTQueryCache.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <fstream>
+#include <iterator>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+namespace fs = boost::filesystem;
+
+optional<string> SMTQueryCache::lookup(string const& _solver, string const& _query) const
+{
+	ifstream file(entryPath(_solver, _query).string(), ios::binary);
+	if (!file)
+		return nullopt;
+	string answer{istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+	if (file.bad())
+		return nullopt;
+	return answer;
+}
+
+void SMTQueryCache::store(string const& _solver, string const& _query, string const& _answer) const
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	// Write to a temporary file first, so that concurrent readers never see partial answers.
+	fs::path entry = entryPath(_solver, _query);
+	fs::path temporary = fs::unique_path(entry.string() + ".%%%%-%%%%-%%%%", error);
+	if (error)
+		return;
+	{
+		ofstream file(temporary.string(), ios::binary | ios::trunc);
+		file << _answer;
+		if (!file)
+		{
+			fs::remove(temporary, error);
+			return;
+		}
+	}
+	fs::rename(temporary, entry, error);
+	if (error)
+		fs::remove(temporary, error);
+}
+
+fs::path SMTQueryCache::entryPath(string const& _solver, string const& _query) const
+{
+	return m_directory / keccak256(_solver + '\0' + _query).hex();
+}
@@ -0,0 +1,58 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+#include <string>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Persistent store of the answers of SMT solvers, so that later runs of the compiler
+ * do not have to ask the solvers the same queries again.
+ *
+ * Every answer is stored in its own file in the cache directory, named after the hash
+ * of the query and of the identity of the solver that answered it. The identity has
+ * to contain everything that may change the answer apart from the query itself,
+ * in particular the version of the solver and its resource limits.
+ * A cache directory can be shared by concurrent threads and processes.
+ */
+class SMTQueryCache
+{
+public:
+	explicit SMTQueryCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the answer of @a _solver to @a _query, if it is stored.
+	std::optional<std::string> lookup(std::string const& _solver, std::string const& _query) const;
+	/// Stores @a _answer of @a _solver to @a _query. Errors while writing are ignored
+	/// since the answer can always be computed again.
+	void store(std::string const& _solver, std::string const& _query, std::string const& _answer) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(std::string const& _solver, std::string const& _query) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
@@ -530,9 +530,19 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a call to check() that runs in another thread to return as soon as possible,
+	/// usually with an UNKNOWN result. Does nothing if the solver cannot be interrupted.
+	/// Must only be called while check() is running, since some solvers fail
+	/// their next call if interrupted while idle.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
+	/// @returns why the last call to check() returned UNKNOWN, for example "timeout" or
+	/// "resource limit", or an empty string if the solver did not say.
+	virtual std::string unknownReason() const { return {}; }
+
 	/// @returns how many SMT solvers this interface has.
 	virtual size_t solvers() { return 1; }
 
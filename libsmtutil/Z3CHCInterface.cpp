@@ -18,20 +18,64 @@
 
 #include <libsmtutil/Z3CHCInterface.h>
 
+#include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
 
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/split.hpp>
+
+#include <range/v3/view/map.hpp>
+
+#include <atomic>
 #include <set>
 #include <stack>
+#include <thread>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::smtutil;
 
-Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
+namespace
+{
+
+/// @returns the indices of the relations in @a _relationIndices that occur in @a _expr.
+set<unsigned> relationsIn(z3::expr const& _expr, map<string, unsigned> const& _relationIndices)
+{
+	set<unsigned> relations;
+	set<unsigned> visited;
+	stack<z3::expr> expressions;
+	expressions.push(_expr);
+	while (!expressions.empty())
+	{
+		z3::expr expr = expressions.top();
+		expressions.pop();
+		if (!visited.insert(expr.id()).second)
+			continue;
+		if (expr.is_quantifier())
+			expressions.push(expr.body());
+		else if (expr.is_app())
+		{
+			if (auto relation = _relationIndices.find(expr.decl().name().str()); relation != _relationIndices.end())
+				relations.insert(relation->second);
+			for (unsigned i = 0; i < expr.num_args(); ++i)
+				expressions.push(expr.arg(i));
+		}
+	}
+	return relations;
+}
+
+}
+
+Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout, shared_ptr<SMTQueryCache const> _queryCache):
 	CHCSolverInterface(_queryTimeout),
 	m_z3Interface(make_unique<Z3Interface>(m_queryTimeout)),
 	m_context(m_z3Interface->context()),
-	m_solver(*m_context)
+	m_solver(*m_context),
+	m_relations(*m_context),
+	m_rules(*m_context),
+	m_queryCache(std::move(_queryCache))
 {
 	Z3_get_version(
 		&get<0>(m_version),
@@ -59,31 +103,521 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
-	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	z3::func_decl relation = m_z3Interface->functions().at(_expr.name);
+	m_solver.register_relation(relation);
+	m_relations.push_back(relation);
+	if (m_queryCache)
+	{
+		m_relationIndices.emplace(relation.name().str(), m_relations.size() - 1);
+		m_lemmaKeys.clear();
+	}
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
-	if (m_z3Interface->constants().empty())
-		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
-	else
+	if (!m_z3Interface->constants().empty())
 	{
 		z3::expr_vector variables(*m_context);
 		for (auto const& var: m_z3Interface->constants())
 			variables.push_back(var.second);
-		z3::expr boundRule = z3::forall(variables, rule);
-		m_solver.add_rule(boundRule, m_context->str_symbol(_name.c_str()));
+		rule = z3::forall(variables, rule);
+	}
+	m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
+	m_rules.push_back(rule);
+	m_ruleNames.push_back(_name);
+	if (m_queryCache)
+	{
+		CachedRule cachedRule{rule.to_string(), {}, relationsIn(rule, m_relationIndices)};
+		z3::expr body = rule.is_quantifier() ? rule.body() : rule;
+		z3::expr head = body.is_app() && body.decl().decl_kind() == Z3_OP_IMPLIES ? body.arg(1) : body;
+		if (head.is_app())
+			if (auto relation = m_relationIndices.find(head.decl().name().str()); relation != m_relationIndices.end())
+				cachedRule.head = relation->second;
+		m_cachedRules.emplace_back(std::move(cachedRule));
+		m_lemmaKeys.clear();
 	}
 }
 
 tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
 {
+	return query(m_z3Interface->toZ3Expr(_expr));
+}
+
+tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::queryWithCounterexample(Expression const& _expr)
+{
+	return queryWithCache(m_z3Interface->toZ3Expr(_expr));
+}
+
+vector<tuple<CheckResult, Expression, CHCSolverInterface::CexGraph>> Z3CHCInterface::queryInParallel(
+	vector<Expression> const& _queries,
+	unsigned _threads,
+	vector<chrono::steady_clock::duration>* _times,
+	vector<string>* _unknownReasons
+)
+{
+	smtAssert(_threads > 0, "");
+	vector<tuple<CheckResult, Expression, CexGraph>> results(_queries.size(), {CheckResult::ERROR, Expression(true), {}});
+	vector<exception_ptr> errors(_queries.size());
+	if (_times)
+		_times->assign(_queries.size(), {});
+	if (_unknownReasons)
+		_unknownReasons->assign(_queries.size(), {});
+	if (_queries.empty())
+		return results;
+
+	z3::expr_vector queries(*m_context);
+	for (auto const& query: _queries)
+		queries.push_back(m_z3Interface->toZ3Expr(query));
+
+	// The solvers are created and filled here and not by the threads, since their
+	// constructors set global solver parameters and the translation reads this context.
+	vector<unique_ptr<Z3CHCInterface>> workers;
+	vector<z3::expr_vector> workerQueries;
+	for (size_t i = 0; i < min<size_t>(_threads, _queries.size()); ++i)
+	{
+		workers.emplace_back(copy());
+		workerQueries.emplace_back(*workers.back()->m_context, queries);
+	}
+
+	// Spacer only uses covers given before the first query of a solver, so every
+	// query with stored lemmas is solved by its own seeded solver.
+	vector<string> keys(_queries.size());
+	vector<bool> cached(_queries.size(), false);
+	vector<unique_ptr<Z3CHCInterface>> seeded(_queries.size());
+	vector<z3::expr_vector> seededQueries;
+	// This also computes the keys of the lemmas here, since the threads only read them.
+	vector<optional<string>> lemmas;
+	if (m_queryCache)
+		lemmas = storedLemmas();
+	for (size_t i = 0; i < _queries.size(); ++i)
+	{
+		if (m_queryCache)
+		{
+			keys[i] = cachedQuery(queries[static_cast<unsigned>(i)]);
+			if (auto entry = m_queryCache->lookup(cachedSolver(), keys[i]))
+				if (auto answer = cachedAnswer(*entry))
+				{
+					results[i] = std::move(*answer);
+					cached[i] = true;
+				}
+			if (!cached[i])
+				seeded[i] = seededCopy(lemmas);
+		}
+		seededQueries.emplace_back(seeded[i] ? *seeded[i]->m_context : *m_context);
+		if (seeded[i])
+			seededQueries.back().push_back(z3::expr(*seeded[i]->m_context, Z3_translate(*m_context, queries[static_cast<unsigned>(i)], *seeded[i]->m_context)));
+	}
+
+	atomic<size_t> nextQuery{0};
+	auto solveQueries = [&](size_t _worker)
+	{
+		for (size_t i = nextQuery++; i < _queries.size(); i = nextQuery++)
+			try
+			{
+				if (cached[i])
+					continue;
+				Z3CHCInterface& solver = seeded[i] ? *seeded[i] : *workers[_worker];
+				z3::expr query = seeded[i] ? seededQueries[i][0] : workerQueries[_worker][static_cast<unsigned>(i)];
+				auto start = chrono::steady_clock::now();
+				string entry;
+				results[i] = solver.queryWithCounterexample(query, m_queryCache ? &entry : nullptr);
+				if (_times)
+					(*_times)[i] = chrono::steady_clock::now() - start;
+				if (_unknownReasons)
+					(*_unknownReasons)[i] = solver.m_unknownReason;
+				if (m_queryCache)
+				{
+					if (!entry.empty())
+						m_queryCache->store(cachedSolver(), keys[i], entry);
+					if (get<0>(results[i]) == CheckResult::UNSATISFIABLE)
+						storeLemmas(solver);
+				}
+			}
+			catch (...)
+			{
+				errors[i] = current_exception();
+			}
+	};
+
+	vector<thread> threads;
+	for (size_t i = 1; i < workers.size(); ++i)
+		threads.emplace_back(solveQueries, i);
+	solveQueries(0);
+	for (auto& t: threads)
+		t.join();
+
+	for (auto const& error: errors)
+		if (error)
+			rethrow_exception(error);
+	return results;
+}
+
+tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::queryWithCounterexample(z3::expr const& _expr, string* _cacheEntry)
+{
+	auto [result, invariant, cex] = query(_expr, _cacheEntry);
+	if (result == CheckResult::SATISFIABLE)
+	{
+		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
+		// We now disable those optimizations and check whether we can still solve the problem.
+		setSpacerOptions(false);
+		string cacheEntryNoOpt;
+		auto [resultNoOpt, invariantNoOpt, cexNoOpt] = query(_expr, _cacheEntry ? &cacheEntryNoOpt : nullptr);
+		if (resultNoOpt == CheckResult::SATISFIABLE)
+		{
+			cex = std::move(cexNoOpt);
+			if (_cacheEntry)
+				*_cacheEntry = std::move(cacheEntryNoOpt);
+		}
+		setSpacerOptions(true);
+		// The answer is SAT, even if the second query gave up.
+		m_unknownReason.clear();
+	}
+	return {result, std::move(invariant), std::move(cex)};
+}
+
+tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::queryWithCache(z3::expr const& _expr)
+{
+	if (!m_queryCache)
+		return queryWithCounterexample(_expr);
+	m_unknownReason.clear();
+
+	string key = cachedQuery(_expr);
+	if (auto entry = m_queryCache->lookup(cachedSolver(), key))
+		if (auto answer = cachedAnswer(*entry))
+			return std::move(*answer);
+
+	unique_ptr<Z3CHCInterface> seeded = seededCopy(storedLemmas());
+	Z3CHCInterface& solver = seeded ? *seeded : *this;
+	string entry;
+	auto result = solver.queryWithCounterexample(
+		seeded ? z3::expr(*seeded->m_context, Z3_translate(*m_context, _expr, *seeded->m_context)) : _expr,
+		&entry
+	);
+	if (!entry.empty())
+		m_queryCache->store(cachedSolver(), key, entry);
+	if (get<0>(result) == CheckResult::UNSATISFIABLE)
+		storeLemmas(solver);
+	m_unknownReason = solver.m_unknownReason;
+	return result;
+}
+
+unique_ptr<Z3CHCInterface> Z3CHCInterface::copy() const
+{
+	auto solver = make_unique<Z3CHCInterface>(m_queryTimeout);
+	z3::context& context = *solver->m_context;
+	solver->m_relations = z3::func_decl_vector(context, m_relations);
+	for (unsigned i = 0; i < solver->m_relations.size(); ++i)
+	{
+		z3::func_decl relation = solver->m_relations[i];
+		solver->m_solver.register_relation(relation);
+	}
+	solver->m_rules = z3::expr_vector(context, m_rules);
+	solver->m_ruleNames = m_ruleNames;
+	for (unsigned i = 0; i < solver->m_rules.size(); ++i)
+	{
+		z3::expr rule = solver->m_rules[i];
+		solver->m_solver.add_rule(rule, context.str_symbol(m_ruleNames[i].c_str()));
+	}
+	return solver;
+}
+
+string Z3CHCInterface::cachedQuery(z3::expr const& _query) const
+{
+	string system;
+	for (unsigned i = 0; i < m_relations.size(); ++i)
+		system += m_relations[i].to_string() + "\n";
+	for (size_t i = 0; i < m_cachedRules.size(); ++i)
+		system += "(rule " + m_cachedRules[i].text + " " + m_ruleNames[i] + ")\n";
+	return system + "(query " + _query.to_string() + ")\n";
+}
+
+string Z3CHCInterface::cachedSolver() const
+{
+	string solver = string("z3 ") + Z3_get_full_version() + " spacer";
+	if (m_queryTimeout)
+		solver += " timeout " + to_string(*m_queryTimeout);
+	else
+		solver += " rlimit " + to_string(Z3Interface::resourceLimit);
+	return solver;
+}
+
+optional<tuple<CheckResult, Expression, CHCSolverInterface::CexGraph>> Z3CHCInterface::cachedAnswer(string const& _entry)
+{
+	try
+	{
+		if (boost::starts_with(_entry, "unsat\n"))
+		{
+			z3::expr_vector invariants = parseAssertions(_entry.substr(6), z3::func_decl_vector(*m_context));
+			if (invariants.size() != 1)
+				return nullopt;
+			return {{CheckResult::UNSATISFIABLE, m_z3Interface->fromZ3Expr(invariants[0]), {}}};
+		}
+		if (!boost::starts_with(_entry, "sat\n"))
+			return nullopt;
+
+		// The node ids and the edges of the counterexample come first, then the facts of the nodes.
+		CexGraph graph;
+		vector<unsigned> nodes;
+		size_t position = 4;
+		while (position < _entry.size() && _entry[position] != '(')
+		{
+			size_t lineEnd = _entry.find('\n', position);
+			if (lineEnd == string::npos)
+				return nullopt;
+			vector<string> fields;
+			boost::split(fields, _entry.substr(position, lineEnd - position), boost::is_any_of(" "));
+			position = lineEnd + 1;
+			vector<unsigned> ids;
+			for (size_t i = 1; i < fields.size(); ++i)
+				ids.push_back(static_cast<unsigned>(stoul(fields[i])));
+			if (fields.front() == "node" && ids.size() == 1)
+				nodes.push_back(ids.front());
+			else if (fields.front() == "edges" && !ids.empty())
+				graph.edges[ids.front()] = vector<unsigned>(ids.begin() + 1, ids.end());
+			else
+				return nullopt;
+		}
+		z3::expr_vector facts = parseAssertions(_entry.substr(position), z3::func_decl_vector(*m_context));
+		if (facts.size() != nodes.size())
+			return nullopt;
+		for (size_t i = 0; i < nodes.size(); ++i)
+			graph.nodes.emplace(nodes[i], m_z3Interface->fromZ3Expr(facts[static_cast<unsigned>(i)]));
+		return {{CheckResult::SATISFIABLE, Expression(true), std::move(graph)}};
+	}
+	catch (...)
+	{
+		return nullopt;
+	}
+}
+
+string Z3CHCInterface::lemmaSolver()
+{
+	return string("z3 ") + Z3_get_full_version() + " spacer lemmas";
+}
+
+vector<string> const& Z3CHCInterface::lemmaKeys()
+{
+	smtAssert(m_queryCache, "");
+	if (m_lemmaKeys.size() != m_relations.size())
+	{
+		m_lemmaKeys.clear();
+		for (unsigned i = 0; i < m_relations.size(); ++i)
+			m_lemmaKeys.emplace_back(lemmaKey(i));
+	}
+	return m_lemmaKeys;
+}
+
+string Z3CHCInterface::lemmaKey(unsigned _relation) const
+{
+	// The relations the lemmas may depend on, and the rules that define them in the order they were added.
+	set<unsigned> relations{_relation};
+	vector<bool> included(m_cachedRules.size(), false);
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (size_t i = 0; i < m_cachedRules.size(); ++i)
+			if (!included[i] && m_cachedRules[i].head && relations.count(*m_cachedRules[i].head))
+			{
+				included[i] = true;
+				changed = true;
+				relations += m_cachedRules[i].relations;
+			}
+	}
+
+	set<string> renamed;
+	for (unsigned relation: relations)
+		renamed.insert(m_relations[relation].name().str());
+	for (auto const& name: m_z3Interface->constants() | ranges::views::keys)
+		renamed.insert(name);
+
+	// Replaces the symbols in renamed by their order of occurrence. They are never quoted, since
+	// Solidity identifiers only contain letters, digits, '_' and '$', so quoted symbols are kept.
+	map<string, string> names{{m_relations[_relation].name().str(), "r#0"}};
+	auto rename = [&](string const& _text) {
+		string result;
+		for (size_t position = 0; position < _text.size();)
+		{
+			size_t end;
+			if (_text[position] == '|')
+				end = min(_text.find('|', position + 1), _text.size() - 1) + 1;
+			else if (string(" \t\n()").find(_text[position]) != string::npos)
+				end = position + 1;
+			else
+				end = min(_text.find_first_of(" \t\n()|", position), _text.size());
+			string token = _text.substr(position, end - position);
+			if (renamed.count(token))
+			{
+				auto name = names.find(token);
+				if (name == names.end())
+					name = names.emplace(token, "r#" + to_string(names.size())).first;
+				token = name->second;
+			}
+			result += token;
+			position = end;
+		}
+		return result;
+	};
+
+	string key = rename(m_relations[_relation].to_string()) + "\n";
+	for (size_t i = 0; i < m_cachedRules.size(); ++i)
+		if (included[i])
+			key += rename(m_cachedRules[i].text) + "\n";
+	return util::keccak256(key).hex();
+}
+
+vector<optional<string>> Z3CHCInterface::storedLemmas()
+{
+	vector<optional<string>> lemmas;
+	for (string const& key: lemmaKeys())
+		lemmas.emplace_back(m_queryCache->lookup(lemmaSolver(), key));
+	return lemmas;
+}
+
+void Z3CHCInterface::storeLemmas(Z3CHCInterface& _solver) const
+{
+	smtAssert(m_lemmaKeys.size() == m_relations.size(), "");
+	for (unsigned i = 0; i < m_relations.size(); ++i)
+	{
+		string lemmas = _solver.learnedLemmas(i);
+		if (!lemmas.empty())
+			m_queryCache->store(lemmaSolver(), m_lemmaKeys[i], lemmas);
+	}
+}
+
+unique_ptr<Z3CHCInterface> Z3CHCInterface::seededCopy(vector<optional<string>> const& _lemmas) const
+{
+	smtAssert(_lemmas.size() == m_relations.size(), "");
+	vector<pair<unsigned, z3::expr>> covers;
+	for (unsigned i = 0; i < m_relations.size(); ++i)
+		if (_lemmas[i])
+			if (auto cover = parseLemmas(i, *_lemmas[i]); cover && !cover->is_true())
+				covers.emplace_back(i, *cover);
+	if (covers.empty())
+		return nullptr;
+
+	auto solver = copy();
+	solver->m_slicing = false;
+	solver->setSpacerOptions();
+	try
+	{
+		for (auto const& [index, cover]: covers)
+		{
+			z3::func_decl relation = solver->m_relations[index];
+			z3::expr seededCover(*solver->m_context, Z3_translate(*m_context, cover, *solver->m_context));
+			solver->m_solver.add_cover(-1, relation, seededCover);
+		}
+	}
+	catch (z3::exception const&)
+	{
+		return nullptr;
+	}
+	return solver;
+}
+
+namespace
+{
+
+/// @returns the name of the constant that stands for argument @a _argument of a relation in stored lemmas.
+/// Solidity identifiers cannot contain '#', so the name does not clash with other symbols.
+string lemmaArgumentName(unsigned _argument)
+{
+	return "lemma#" + to_string(_argument);
+}
+
+/// Adds @a _sort and the sorts it is composed of to @a _sorts if they are tuples,
+/// since the SMT-LIB2 parser needs to know them to parse their constructors and accessors.
+void collectTupleSorts(z3::sort const& _sort, map<string, z3::sort>& _sorts)
+{
+	if (_sort.is_array())
+	{
+		collectTupleSorts(_sort.array_domain(), _sorts);
+		collectTupleSorts(_sort.array_range(), _sorts);
+	}
+	else if (_sort.is_datatype() && !_sorts.count(_sort.name().str()))
+	{
+		_sorts.emplace(_sort.name().str(), _sort);
+		z3::context& context = _sort.ctx();
+		unsigned fields = Z3_get_tuple_sort_num_fields(context, _sort);
+		for (unsigned i = 0; i < fields; ++i)
+			collectTupleSorts(z3::func_decl(context, Z3_get_tuple_sort_field_decl(context, _sort, i)).range(), _sorts);
+	}
+}
+
+}
+
+optional<z3::expr> Z3CHCInterface::parseLemmas(unsigned _relation, string const& _lemmas) const
+{
+	z3::func_decl relation = m_relations[_relation];
+	z3::expr_vector arguments(*m_context);
+	z3::expr_vector variables(*m_context);
+	z3::func_decl_vector declarations(*m_context);
+	for (unsigned i = 0; i < relation.arity(); ++i)
+	{
+		z3::expr argument = m_context->constant(lemmaArgumentName(i).c_str(), relation.domain(i));
+		arguments.push_back(argument);
+		variables.push_back(z3::expr(*m_context, Z3_mk_bound(*m_context, i, relation.domain(i))));
+		declarations.push_back(argument.decl());
+	}
+
+	try
+	{
+		z3::expr cover = m_context->bool_val(true);
+		z3::expr_vector lemmas = parseAssertions(_lemmas, declarations);
+		for (unsigned i = 0; i < lemmas.size(); ++i)
+			cover = cover && lemmas[i].substitute(arguments, variables);
+		return cover;
+	}
+	catch (z3::exception const&)
+	{
+		return nullopt;
+	}
+}
+
+z3::expr_vector Z3CHCInterface::parseAssertions(string const& _text, z3::func_decl_vector _declarations) const
+{
+	map<string, z3::sort> sorts;
+	for (auto const& [name, function]: m_z3Interface->functions())
+	{
+		_declarations.push_back(function);
+		for (unsigned i = 0; i < function.arity(); ++i)
+			collectTupleSorts(function.domain(i), sorts);
+		collectTupleSorts(function.range(), sorts);
+	}
+	z3::sort_vector tupleSorts(*m_context);
+	for (auto const& sort: sorts | ranges::views::values)
+		tupleSorts.push_back(sort);
+	return m_context->parse_string(_text.c_str(), tupleSorts, _declarations);
+}
+
+string Z3CHCInterface::learnedLemmas(unsigned _relation)
+{
+	try
+	{
+		z3::func_decl relation = m_relations[_relation];
+		z3::expr cover = m_solver.get_cover_delta(-1, relation);
+		if (cover.is_true())
+			return {};
+		z3::expr_vector arguments(*m_context);
+		for (unsigned i = 0; i < relation.arity(); ++i)
+			arguments.push_back(m_context->constant(lemmaArgumentName(i).c_str(), relation.domain(i)));
+		return "(assert " + cover.substitute(arguments).to_string() + ")\n";
+	}
+	catch (z3::exception const&)
+	{
+		return {};
+	}
+}
+
+tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::query(z3::expr _expr, string* _cacheEntry)
+{
+	if (_cacheEntry)
+		_cacheEntry->clear();
+	m_unknownReason.clear();
 	CheckResult result;
 	try
 	{
-		z3::expr z3Expr = m_z3Interface->toZ3Expr(_expr);
-		switch (m_solver.query(z3Expr))
+		switch (m_solver.query(_expr))
 		{
 		case z3::check_result::sat:
 		{
@@ -93,19 +627,23 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::que
 			if (m_version >= tuple(4, 8, 8, 0))
 			{
 				auto proof = m_solver.get_answer();
-				return {result, Expression(true), cexGraph(proof)};
+				return {result, Expression(true), cexGraph(proof, _cacheEntry)};
 			}
 			break;
 		}
 		case z3::check_result::unsat:
 		{
 			result = CheckResult::UNSATISFIABLE;
-			auto invariants = m_z3Interface->fromZ3Expr(m_solver.get_answer());
+			z3::expr answer = m_solver.get_answer();
+			if (_cacheEntry)
+				*_cacheEntry = "unsat\n(assert " + answer.to_string() + ")\n";
+			auto invariants = m_z3Interface->fromZ3Expr(answer);
 			return {result, std::move(invariants), {}};
 		}
 		case z3::check_result::unknown:
 		{
 			result = CheckResult::UNKNOWN;
+			m_unknownReason = Z3Interface::normalizedUnknownReason(m_solver.reason_unknown());
 			break;
 		}
 		}
@@ -120,7 +658,10 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::que
 			"canceled"
 		};
 		if (msgs.count(_err.msg()))
+		{
 			result = CheckResult::UNKNOWN;
+			m_unknownReason = Z3Interface::normalizedUnknownReason(_err.msg());
+		}
 		else
 			result = CheckResult::ERROR;
 	}
@@ -144,7 +685,7 @@ void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 	// Spacer optimization should be
 	// - enabled for better solving (default)
 	// - disable for counterexample generation
-	p.set("fp.xform.slice", _preProcessing);
+	p.set("fp.xform.slice", _preProcessing && m_slicing);
 	p.set("fp.xform.inline_linear", _preProcessing);
 	p.set("fp.xform.inline_eager", _preProcessing);
 
@@ -164,7 +705,7 @@ which generates linear counterexamples.
 It is modified here to accept nonlinear CHCs as well, generating a DAG
 instead of a path.
 */
-CHCSolverInterface::CexGraph Z3CHCInterface::cexGraph(z3::expr const& _proof)
+CHCSolverInterface::CexGraph Z3CHCInterface::cexGraph(z3::expr const& _proof, string* _cacheEntry)
 {
 	/// The root fact of the refutation proof is `false`.
 	/// The node itself is not a hyper resolution, so we need to
@@ -174,15 +715,22 @@ CHCSolverInterface::CexGraph Z3CHCInterface::cexGraph(z3::expr const& _proof)
 	/// If an older version is used, this check will fail and no
 	/// counterexample will be generated.
 	if (!_proof.is_app() || fact(_proof).decl().decl_kind() != Z3_OP_FALSE)
+	{
+		if (_cacheEntry)
+			*_cacheEntry = "sat\n";
 		return {};
+	}
 
 	CexGraph graph;
+	map<unsigned, z3::expr> facts;
 
 	stack<z3::expr> proofStack;
 	proofStack.push(_proof.arg(0));
 
 	auto const& root = proofStack.top();
 	graph.nodes.emplace(root.id(), m_z3Interface->fromZ3Expr(fact(root)));
+	if (_cacheEntry)
+		facts.emplace(root.id(), fact(root));
 
 	set<unsigned> visited;
 	visited.insert(root.id());
@@ -209,6 +757,8 @@ CHCSolverInterface::CexGraph Z3CHCInterface::cexGraph(z3::expr const& _proof)
 				{
 					graph.nodes.emplace(child.id(), m_z3Interface->fromZ3Expr(fact(child)));
 					graph.edges[child.id()] = {};
+					if (_cacheEntry)
+						facts.emplace(child.id(), fact(child));
 				}
 
 				graph.edges[proofNode.id()].push_back(child.id());
@@ -216,6 +766,34 @@ CHCSolverInterface::CexGraph Z3CHCInterface::cexGraph(z3::expr const& _proof)
 		}
 	}
 
+	if (_cacheEntry)
+	{
+		// The ids are kept, since the counterexample is built in the order of the ids of its nodes.
+		*_cacheEntry = "sat\n";
+		for (unsigned id: facts | ranges::views::keys)
+			*_cacheEntry += "node " + to_string(id) + "\n";
+		for (auto const& [id, children]: graph.edges)
+		{
+			*_cacheEntry += "edges " + to_string(id);
+			for (unsigned child: children)
+				*_cacheEntry += " " + to_string(child);
+			*_cacheEntry += "\n";
+		}
+		// The query is represented by a relation that z3 declares itself.
+		// The relations are looked up by name, since copies of this solver do not declare them in m_z3Interface.
+		set<string> declared;
+		for (unsigned i = 0; i < m_relations.size(); ++i)
+			declared.insert(m_relations[i].name().str());
+		for (z3::expr const& nodeFact: facts | ranges::views::values)
+		{
+			string name = nodeFact.decl().name().str();
+			if (declared.insert(name).second)
+				*_cacheEntry += nodeFact.decl().to_string() + "\n";
+		}
+		for (z3::expr const& nodeFact: facts | ranges::views::values)
+			*_cacheEntry += "(assert " + nodeFact.to_string() + ")\n";
+	}
+
 	return graph;
 }
 
@@ -25,16 +25,34 @@
 #include <libsmtutil/CHCSolverInterface.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <chrono>
+#include <map>
+#include <optional>
+#include <set>
 #include <tuple>
 #include <vector>
 
 namespace solidity::smtutil
 {
 
+/**
+ * If a query cache is given, the answers of queryWithCounterexample and queryInParallel are
+ * stored in it, keyed by the text of the Horn system and of the query, and reused when the same
+ * query is asked about the same system again, for example by a later run of the compiler.
+ * The inductive lemmas Spacer learns for the relations while proving a query unreachable are
+ * stored as well, for each relation on its own. They are keyed by the rules the relation depends on,
+ * with the names of the relations and variables replaced by their order of occurrence, so that they
+ * are found again when unrelated rules or the AST node ids in the names change. When a query that
+ * is not answered by the cache is solved, the stored lemmas are given to the solver as covers of
+ * the relations.
+ */
 class Z3CHCInterface: public CHCSolverInterface
 {
 public:
-	Z3CHCInterface(std::optional<unsigned> _queryTimeout = {});
+	Z3CHCInterface(
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<SMTQueryCache const> _queryCache = nullptr
+	);
 
 	/// Forwards variable declaration to Z3Interface.
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
@@ -45,13 +63,74 @@ public:
 
 	std::tuple<CheckResult, Expression, CexGraph> query(Expression const& _expr) override;
 
+	std::string unknownReason() const override { return m_unknownReason; }
+
+	/// Like query, but if @a _expr is reachable it is queried again without Spacer's
+	/// preprocessing, since the preprocessing makes counterexamples incomplete.
+	std::tuple<CheckResult, Expression, CexGraph> queryWithCounterexample(Expression const& _expr);
+
+	/// Calls queryWithCounterexample for each of @a _queries, using up to @a _threads copies
+	/// of this solver that solve the queries concurrently, each with its own z3 context that
+	/// contains the relations and rules added so far.
+	/// @returns the results in the order of the queries.
+	/// If @a _times is not null, it is set to the time each query took.
+	/// If @a _unknownReasons is not null, it is set to the reason of each UNKNOWN result.
+	std::vector<std::tuple<CheckResult, Expression, CexGraph>> queryInParallel(
+		std::vector<Expression> const& _queries,
+		unsigned _threads,
+		std::vector<std::chrono::steady_clock::duration>* _times = nullptr,
+		std::vector<std::string>* _unknownReasons = nullptr
+	);
+
 	Z3Interface* z3Interface() const { return m_z3Interface.get(); }
 
 	void setSpacerOptions(bool _preProcessing = true);
 
 private:
+	/// If @a _cacheEntry is not null, it is set to the answer in the format of the query cache,
+	/// or to the empty string if the answer cannot be stored.
+	std::tuple<CheckResult, Expression, CexGraph> query(z3::expr _expr, std::string* _cacheEntry = nullptr);
+	std::tuple<CheckResult, Expression, CexGraph> queryWithCounterexample(z3::expr const& _expr, std::string* _cacheEntry = nullptr);
+	/// Like queryWithCounterexample, but looks the answer up in the query cache first. Otherwise
+	/// solves @a _expr with a copy of this solver seeded with the stored lemmas if there are any,
+	/// and stores the answer and the learned lemmas.
+	std::tuple<CheckResult, Expression, CexGraph> queryWithCache(z3::expr const& _expr);
+
+	/// @returns a new solver with its own z3 context that contains the relations and rules added so far.
+	std::unique_ptr<Z3CHCInterface> copy() const;
+
+	/// @returns the key of the answer and the lemmas of @a _query in the query cache.
+	std::string cachedQuery(z3::expr const& _query) const;
+	/// @returns the identity of the solver and its limits for the answers in the query cache.
+	std::string cachedSolver() const;
+	/// @returns the answer given by @a _entry of the query cache, if it can be parsed.
+	std::optional<std::tuple<CheckResult, Expression, CexGraph>> cachedAnswer(std::string const& _entry);
+	/// @returns the identity of the solver for the lemmas in the query cache.
+	static std::string lemmaSolver();
+	/// @returns the keys of the lemmas of the relations in the query cache.
+	std::vector<std::string> const& lemmaKeys();
+	/// @returns the key of the lemmas of relation @a _relation in the query cache: the hash of its declaration
+	/// and of the rules that define it and the relations it depends on, in which the relations and variables
+	/// are renamed in the order of their first occurrence.
+	std::string lemmaKey(unsigned _relation) const;
+	/// @returns the lemmas stored in the query cache for each relation.
+	std::vector<std::optional<std::string>> storedLemmas();
+	/// Stores the lemmas @a _solver learned about each relation in its last query.
+	void storeLemmas(Z3CHCInterface& _solver) const;
+	/// @returns a copy of this solver seeded with @a _lemmas of each relation, or nullptr if none of them can be used.
+	std::unique_ptr<Z3CHCInterface> seededCopy(std::vector<std::optional<std::string>> const& _lemmas) const;
+	/// @returns the cover of relation @a _relation given by @a _lemmas, or nullopt if they cannot be parsed.
+	std::optional<z3::expr> parseLemmas(unsigned _relation, std::string const& _lemmas) const;
+	/// @returns the assertions in @a _text, which may use the functions declared so far and @a _declarations.
+	/// Throws z3::exception if they cannot be parsed.
+	z3::expr_vector parseAssertions(std::string const& _text, z3::func_decl_vector _declarations) const;
+	/// @returns the lemmas learned by the last query about relation @a _relation, as SMT-LIB2 assertions
+	/// over its arguments, or an empty string if there are none.
+	std::string learnedLemmas(unsigned _relation);
+
 	/// Constructs a nonlinear counterexample graph from the refutation.
-	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
+	/// If @a _cacheEntry is not null, it is set to the graph in the format of the query cache.
+	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof, std::string* _cacheEntry = nullptr);
 	/// @returns the fact from a proof node.
 	z3::expr fact(z3::expr const& _node);
 	/// @returns @a _predicate's name.
@@ -66,6 +145,31 @@ private:
 	// Horn solver.
 	z3::fixedpoint m_solver;
 
+	/// The relations and rules given to m_solver, which are copied into
+	/// the contexts of the solvers used by queryInParallel.
+	z3::func_decl_vector m_relations;
+	z3::expr_vector m_rules;
+	std::vector<std::string> m_ruleNames;
+
+	std::shared_ptr<SMTQueryCache const> m_queryCache;
+	/// A rule in textual form with the relations it refers to, only built if there is a query cache.
+	struct CachedRule
+	{
+		std::string text;
+		/// The index of the relation the rule defines, if its head is a relation.
+		std::optional<unsigned> head;
+		/// The indices of all relations in the rule.
+		std::set<unsigned> relations;
+	};
+	std::vector<CachedRule> m_cachedRules;
+	std::map<std::string, unsigned> m_relationIndices;
+	/// The keys of the lemmas of the relations, computed when they are needed and reset when a rule is added.
+	std::vector<std::string> m_lemmaKeys;
+	/// Spacer does not accept covers for sliced relations, so slicing is disabled in seeded solvers.
+	bool m_slicing = true;
+
+	std::string m_unknownReason;
+
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
 };
 
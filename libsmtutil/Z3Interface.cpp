@@ -26,10 +26,64 @@
 #include <libsmtutil/Z3Loader.h>
 #endif
 
+#include <boost/algorithm/string/predicate.hpp>
+
 using namespace std;
 using namespace solidity::smtutil;
 using namespace solidity::util;
 
+namespace
+{
+
+/// Encodes a SAT or UNSAT result and the model values for the query cache.
+string encodeCachedAnswer(CheckResult _result, vector<string> const& _values)
+{
+	string answer = _result == CheckResult::SATISFIABLE ? "sat\n" : "unsat\n";
+	for (string const& value: _values)
+		answer += to_string(value.size()) + "\n" + value + "\n";
+	return answer;
+}
+
+optional<pair<CheckResult, vector<string>>> decodeCachedAnswer(string const& _answer, size_t _expectedValues)
+{
+	size_t position = _answer.find('\n');
+	if (position == string::npos)
+		return nullopt;
+	string const result = _answer.substr(0, position++);
+	if (result != "sat" && result != "unsat")
+		return nullopt;
+
+	vector<string> values;
+	while (position < _answer.size())
+	{
+		size_t lineEnd = _answer.find('\n', position);
+		if (lineEnd == string::npos)
+			return nullopt;
+		size_t size = 0;
+		try
+		{
+			size = stoul(_answer.substr(position, lineEnd - position));
+		}
+		catch (...)
+		{
+			return nullopt;
+		}
+		position = lineEnd + 1;
+		if (_answer.size() - position <= size || _answer[position + size] != '\n')
+			return nullopt;
+		values.emplace_back(_answer.substr(position, size));
+		position += size + 1;
+	}
+
+	if (result == "unsat")
+		return {{CheckResult::UNSATISFIABLE, {}}};
+	if (values.size() != _expectedValues)
+		return nullopt;
+	return {{CheckResult::SATISFIABLE, std::move(values)}};
+}
+
+}
+
 bool Z3Interface::available()
 {
 #ifdef HAVE_Z3_DLOPEN
@@ -39,9 +93,10 @@ bool Z3Interface::available()
 #endif
 }
 
-Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout):
+Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout, shared_ptr<SMTQueryCache const> _queryCache):
 	SolverInterface(_queryTimeout),
-	m_solver(m_context)
+	m_solver(m_context),
+	m_queryCache(std::move(_queryCache))
 {
 	// These need to be set globally.
 	z3::set_param("rewriter.pull_cheap_ite", true);
@@ -97,6 +152,16 @@ void Z3Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	m_unknownReason.clear();
+	string query;
+	if (m_queryCache)
+	{
+		query = cachedQuery(_expressionsToEvaluate);
+		if (auto answer = m_queryCache->lookup(cachedSolver(), query))
+			if (auto decoded = decodeCachedAnswer(*answer, _expressionsToEvaluate.size()))
+				return *decoded;
+	}
+
 	CheckResult result;
 	vector<string> values;
 	try
@@ -111,6 +176,7 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 			break;
 		case z3::check_result::unknown:
 			result = CheckResult::UNKNOWN;
+			m_unknownReason = normalizedUnknownReason(m_solver.reason_unknown());
 			break;
 		}
 
@@ -131,15 +197,61 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 		};
 
 		if (msgs.count(_err.msg()))
+		{
 			result = CheckResult::UNKNOWN;
+			m_unknownReason = normalizedUnknownReason(_err.msg());
+		}
 		else
 			result = CheckResult::ERROR;
 		values.clear();
 	}
 
+	// Unknown results may depend on the load of the machine, so they are not stored.
+	if (m_queryCache && (result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE))
+		m_queryCache->store(cachedSolver(), query, encodeCachedAnswer(result, values));
+
 	return make_pair(result, values);
 }
 
+string Z3Interface::normalizedUnknownReason(string const& _z3Reason)
+{
+	// z3 reports "canceled" if the timeout interrupted it.
+	if (_z3Reason == "timeout" || _z3Reason == "canceled")
+		return "timeout";
+	if (_z3Reason == "max. resource limit exceeded")
+		return "resource limit";
+	// The tactics report which theory they gave up on, e.g. "(incomplete (theory arithmetic))".
+	if (boost::starts_with(_z3Reason, "(incomplete"))
+		return "incomplete";
+	return _z3Reason;
+}
+
+string Z3Interface::cachedQuery(vector<Expression> const& _expressionsToEvaluate)
+{
+	// Z3's benchmark printer names shared subterms after internal AST ids, which differ
+	// between contexts, so the declarations and assertions are printed one by one.
+	string query;
+	for (auto const& [name, constant]: m_constants)
+		query += constant.decl().to_string() + "\n";
+	for (auto const& [name, function]: m_functions)
+		query += function.to_string() + "\n";
+	for (z3::expr const& assertion: m_solver.assertions())
+		query += "(assert " + assertion.to_string() + ")\n";
+	for (Expression const& e: _expressionsToEvaluate)
+		query += "(get-value (" + toZ3Expr(e).to_string() + "))\n";
+	return query;
+}
+
+string Z3Interface::cachedSolver() const
+{
+	string solver = string("z3 ") + Z3_get_full_version();
+	if (m_queryTimeout)
+		solver += " timeout " + to_string(*m_queryTimeout);
+	else
+		solver += " rlimit " + to_string(resourceLimit);
+	return solver;
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
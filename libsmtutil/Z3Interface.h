@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libsmtutil/SMTQueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <z3++.h>
 
@@ -31,7 +32,12 @@ public:
 	Z3Interface(Z3Interface const&) = delete;
 	Z3Interface& operator=(Z3Interface const&) = delete;
 
-	Z3Interface(std::optional<unsigned> _queryTimeout = {});
+	/// If @a _queryCache is given, answers are looked up in and stored to it,
+	/// using the SMT-LIB2 representation of the assertions as query.
+	Z3Interface(
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<SMTQueryCache const> _queryCache = nullptr
+	);
 
 	static bool available();
 
@@ -44,6 +50,8 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override { m_context.interrupt(); }
+	std::string unknownReason() const override { return m_unknownReason; }
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
@@ -53,6 +61,10 @@ public:
 
 	z3::context* context() { return &m_context; }
 
+	/// @returns the reason for an UNKNOWN answer reported by z3 as @a _z3Reason, with the
+	/// reasons caused by the timeout, the resource limit and incomplete theories given short names.
+	static std::string normalizedUnknownReason(std::string const& _z3Reason);
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
@@ -60,6 +72,11 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	/// @returns the representation of the current query for the query cache.
+	std::string cachedQuery(std::vector<Expression> const& _expressionsToEvaluate);
+	/// @returns the identity of the solver and its limits for the query cache.
+	std::string cachedSolver() const;
+
 	z3::sort z3Sort(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
 	smtutil::SortPointer fromZ3Sort(z3::sort const& _sort);
@@ -70,6 +87,9 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+
+	std::shared_ptr<SMTQueryCache const> m_queryCache;
+	std::string m_unknownReason;
 };
 
 }
@@ -60,6 +60,11 @@ ASTNode::ASTNode(int64_t _id, SourceLocation _location):
 {
 }
 
+ASTNode::~ASTNode()
+{
+	TypeProvider::forget(*this);
+}
+
 Declaration const* ASTNode::referencedDeclaration(Expression const& _expression)
 {
 	if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_expression))
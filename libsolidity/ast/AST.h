@@ -76,7 +76,7 @@ public:
 	using SourceLocation = langutil::SourceLocation;
 
 	explicit ASTNode(int64_t _id, SourceLocation _location);
-	virtual ~ASTNode() {}
+	virtual ~ASTNode();
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	int64_t id() const { return int64_t(m_id); }
@@ -122,7 +122,8 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	/// Only changed by the parser, to number the nodes of sources parsed concurrently.
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -136,6 +137,8 @@ private:
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable std::unique_ptr<ASTAnnotation> m_annotation;
 	SourceLocation m_location;
+
+	friend class Parser;
 };
 
 template <class T>
@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/ast/ASTArena.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <cstdint>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+byte* alignUp(byte* _pointer, size_t _alignment)
+{
+	auto address = reinterpret_cast<uintptr_t>(_pointer);
+	return _pointer + (_alignment - address % _alignment) % _alignment;
+}
+
+}
+
+void* ASTArena::allocate(size_t _size, size_t _alignment)
+{
+	solAssert(_alignment > 0 && (_alignment & (_alignment - 1)) == 0, "Alignment must be a power of two.");
+	m_allocatedBytes += _size;
+
+	if (m_next)
+	{
+		byte* start = alignUp(m_next, _alignment);
+		if (start + _size <= m_end)
+		{
+			m_next = start + _size;
+			return start;
+		}
+	}
+
+	// Large blocks get a chunk of their own, so that the rest of the current chunk is not wasted.
+	if (_size + _alignment > m_chunkSize / 4)
+		return alignUp(newChunk(_size + _alignment), _alignment);
+
+	byte* chunk = newChunk(m_chunkSize);
+	byte* start = alignUp(chunk, _alignment);
+	m_next = start + _size;
+	m_end = chunk + m_chunkSize;
+	return start;
+}
+
+byte* ASTArena::newChunk(size_t _size)
+{
+	// Not value-initialized, the memory is constructed by the callers of allocate.
+	m_chunks.emplace_back(new byte[_size]);
+	m_reservedBytes += _size;
+	return m_chunks.back().get();
+}
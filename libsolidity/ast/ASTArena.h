@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Memory arena from which the nodes of an AST are allocated.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Bump allocator that owns the memory of the nodes of one source unit.
+ *
+ * Memory is never returned to the arena individually, it is only released as a whole when
+ * the arena is destroyed. The arena is not thread-safe, so nodes of one arena must only be
+ * allocated by one thread at a time.
+ */
+class ASTArena
+{
+public:
+	explicit ASTArena(size_t _chunkSize = 64 * 1024): m_chunkSize(_chunkSize) {}
+	ASTArena(ASTArena const&) = delete;
+	ASTArena& operator=(ASTArena const&) = delete;
+
+	/// @returns uninitialized memory of @a _size bytes aligned to @a _alignment.
+	void* allocate(size_t _size, size_t _alignment);
+
+	/// @returns the number of bytes handed out by allocate.
+	size_t allocatedBytes() const { return m_allocatedBytes; }
+	/// @returns the number of bytes reserved from the system.
+	size_t reservedBytes() const { return m_reservedBytes; }
+
+private:
+	/// Reserves a new chunk of @a _size bytes and @returns its start.
+	std::byte* newChunk(size_t _size);
+
+	std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+	std::byte* m_next = nullptr;
+	std::byte* m_end = nullptr;
+	size_t const m_chunkSize;
+	size_t m_allocatedBytes = 0;
+	size_t m_reservedBytes = 0;
+};
+
+/**
+ * Standard allocator that takes memory from an ASTArena and keeps the arena alive.
+ * Used with std::allocate_shared, a node and its reference count share one block of the
+ * arena, and the arena is destroyed together with the last node allocated from it.
+ */
+template <typename T>
+class ASTArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ASTArenaAllocator(std::shared_ptr<ASTArena> _arena): m_arena(std::move(_arena)) {}
+	template <typename U>
+	ASTArenaAllocator(ASTArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(sizeof(T) * _count, alignof(T))); }
+	/// Memory is released together with the arena.
+	void deallocate(T*, size_t) {}
+
+	std::shared_ptr<ASTArena> const& arena() const { return m_arena; }
+
+	template <typename U>
+	bool operator==(ASTArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <typename U>
+	bool operator!=(ASTArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<ASTArena> m_arena;
+};
+
+}
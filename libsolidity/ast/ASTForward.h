@@ -120,9 +120,9 @@ struct ASTCompareByID
 	}
 };
 
-// Used as pointers to AST nodes, to be replaced by more clever pointers, e.g. pointers which do
-// not do reference counting but point to a special memory area that is completely released
-// explicitly.
+// Used as pointers to AST nodes. The parser and the JSON importer allocate the nodes of a source
+// unit, including their reference counts, from one ASTArena, which is released as a whole
+// together with the last of them.
 template <class T>
 using ASTPointer = std::shared_ptr<T>;
 
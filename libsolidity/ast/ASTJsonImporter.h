@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTArena.h>
 #include <json/json.h>
 #include <libsolidity/ast/ASTAnnotations.h>
 #include <liblangutil/EVMVersion.h>
@@ -164,6 +165,8 @@ private:
 	std::map<std::string, ASTPointer<SourceUnit>> m_sourceUnits;
 	/// IDs already used by the nodes
 	std::set<int64_t> m_usedIDs;
+	/// Memory of the nodes of the source unit being imported
+	std::shared_ptr<ASTArena> m_arena;
 	/// Configured EVM version
 	langutil::EVMVersion m_evmVersion;
 };
@@ -26,133 +26,31 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-BoolType const TypeProvider::m_boolean{};
-InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
-
-/// The string and bytes unique_ptrs are initialized when they are first used because
-/// they rely on `byte` being available which we cannot guarantee in the static init context.
-unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
-unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
-unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
-unique_ptr<ArrayType> TypeProvider::m_stringStorage;
-unique_ptr<ArrayType> TypeProvider::m_stringMemory;
-
-TupleType const TypeProvider::m_emptyTuple{};
-AddressType const TypeProvider::m_payableAddress{StateMutability::Payable};
-AddressType const TypeProvider::m_address{StateMutability::NonPayable};
-
-array<unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
-	{make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Signed)}
-}};
-
-array<unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
-	{make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Unsigned)}
-}};
-
-array<unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
-	{make_unique<FixedBytesType>(1)},
-	{make_unique<FixedBytesType>(2)},
-	{make_unique<FixedBytesType>(3)},
-	{make_unique<FixedBytesType>(4)},
-	{make_unique<FixedBytesType>(5)},
-	{make_unique<FixedBytesType>(6)},
-	{make_unique<FixedBytesType>(7)},
-	{make_unique<FixedBytesType>(8)},
-	{make_unique<FixedBytesType>(9)},
-	{make_unique<FixedBytesType>(10)},
-	{make_unique<FixedBytesType>(11)},
-	{make_unique<FixedBytesType>(12)},
-	{make_unique<FixedBytesType>(13)},
-	{make_unique<FixedBytesType>(14)},
-	{make_unique<FixedBytesType>(15)},
-	{make_unique<FixedBytesType>(16)},
-	{make_unique<FixedBytesType>(17)},
-	{make_unique<FixedBytesType>(18)},
-	{make_unique<FixedBytesType>(19)},
-	{make_unique<FixedBytesType>(20)},
-	{make_unique<FixedBytesType>(21)},
-	{make_unique<FixedBytesType>(22)},
-	{make_unique<FixedBytesType>(23)},
-	{make_unique<FixedBytesType>(24)},
-	{make_unique<FixedBytesType>(25)},
-	{make_unique<FixedBytesType>(26)},
-	{make_unique<FixedBytesType>(27)},
-	{make_unique<FixedBytesType>(28)},
-	{make_unique<FixedBytesType>(29)},
-	{make_unique<FixedBytesType>(30)},
-	{make_unique<FixedBytesType>(31)},
-	{make_unique<FixedBytesType>(32)}
-}};
-
-array<unique_ptr<MagicType>, 4> const TypeProvider::m_magics{{
-	{make_unique<MagicType>(MagicType::Kind::Block)},
-	{make_unique<MagicType>(MagicType::Kind::Message)},
-	{make_unique<MagicType>(MagicType::Kind::Transaction)},
-	{make_unique<MagicType>(MagicType::Kind::ABI)}
+thread_local vector<TypeProvider*> TypeProvider::m_current;
+
+TypeProvider::TypeProvider()
+{
+	for (unsigned i = 0; i < 32; ++i)
+	{
+		m_intM[i] = make_unique<IntegerType>(8 * (i + 1), IntegerType::Modifier::Signed);
+		m_uintM[i] = make_unique<IntegerType>(8 * (i + 1), IntegerType::Modifier::Unsigned);
+		m_bytesM[i] = make_unique<FixedBytesType>(i + 1);
+	}
 	// MetaType is stored separately
-}};
+	m_magics = {{
+		make_unique<MagicType>(MagicType::Kind::Block),
+		make_unique<MagicType>(MagicType::Kind::Message),
+		make_unique<MagicType>(MagicType::Kind::Transaction),
+		make_unique<MagicType>(MagicType::Kind::ABI)
+	}};
+}
+
+TypeProvider::Scope::~Scope()
+{
+	auto it = find(m_current.rbegin(), m_current.rend(), m_provider);
+	if (it != m_current.rend())
+		m_current.erase(std::next(it).base());
+}
 
 inline void clearCache(Type const& type)
 {
@@ -186,15 +84,73 @@ void TypeProvider::reset()
 	clearCache(m_emptyTuple);
 	clearCache(m_payableAddress);
 	clearCache(m_address);
-	clearCaches(instance().m_intM);
-	clearCaches(instance().m_uintM);
-	clearCaches(instance().m_bytesM);
-	clearCaches(instance().m_magics);
+	clearCaches(m_intM);
+	clearCaches(m_uintM);
+	clearCaches(m_bytesM);
+	clearCaches(m_magics);
+
+	m_generalTypes.clear();
+	m_stringLiteralTypes.clear();
+	m_ufixedMxN.clear();
+	m_fixedMxN.clear();
+
+	m_tupleTypes.clear();
+	m_locationTypes.clear();
+	m_nodeFunctionTypes.clear();
+	m_plainFunctionTypes.clear();
+	m_functionTypes.clear();
+	m_functionTypeDeclarations.clear();
+	m_rationalNumberTypes.clear();
+	m_arrayTypes.clear();
+	m_arraySliceTypes.clear();
+	m_contractTypes.clear();
+	m_enumTypes.clear();
+	m_moduleTypes.clear();
+	m_typeTypes.clear();
+	m_structTypes.clear();
+	m_modifierTypes.clear();
+	m_metaTypes.clear();
+	m_mappingTypes.clear();
+	m_userDefinedValueTypes.clear();
+	m_statistics = {};
+}
+
+/// Erases the entries of @a _types whose key is @a _node or a pair starting with @a _node.
+template <typename Map>
+void eraseNode(Map& _types, ASTNode const* _node)
+{
+	if (_types.empty())
+		return;
+	using Key = typename Map::key_type;
+	if constexpr (is_same_v<Key, ASTNode const*>)
+		_types.erase(_node);
+	else
+	{
+		// The second member of the pair is an enum or bool, whose first value is the default.
+		auto it = _types.lower_bound(Key{_node, {}});
+		while (it != _types.end() && it->first.first == _node)
+			it = _types.erase(it);
+	}
+}
 
-	instance().m_generalTypes.clear();
-	instance().m_stringLiteralTypes.clear();
-	instance().m_ufixedMxN.clear();
-	instance().m_fixedMxN.clear();
+void TypeProvider::forget(ASTNode const& _node)
+{
+	TypeProvider& provider = instance();
+	eraseNode(provider.m_nodeFunctionTypes, &_node);
+	eraseNode(provider.m_contractTypes, &_node);
+	eraseNode(provider.m_enumTypes, &_node);
+	eraseNode(provider.m_moduleTypes, &_node);
+	eraseNode(provider.m_structTypes, &_node);
+	eraseNode(provider.m_modifierTypes, &_node);
+	eraseNode(provider.m_userDefinedValueTypes, &_node);
+	if (provider.m_functionTypeDeclarations.erase(&_node))
+	{
+		for (auto it = provider.m_functionTypes.begin(); it != provider.m_functionTypes.end();)
+			if (get<6>(it->first) == &_node)
+				it = provider.m_functionTypes.erase(it);
+			else
+				++it;
+	}
 }
 
 template <typename T, typename... Args>
@@ -204,6 +160,26 @@ inline T const* TypeProvider::createAndGet(Args&& ... _args)
 	return static_cast<T const*>(instance().m_generalTypes.back().get());
 }
 
+template <typename T, typename Key, typename... Args>
+inline T const* TypeProvider::internAndGet(map<Key, T const*>& _types, Key _key, Args&& ... _args)
+{
+	Statistics& statistics = instance().m_statistics;
+	++statistics.requests;
+
+	auto i = _types.find(_key);
+	if (i != _types.end())
+	{
+		++statistics.hits;
+		return i->second;
+	}
+
+	// The type is created before it is inserted, because its constructor may request other types.
+	T const* type = createAndGet<T>(std::forward<Args>(_args)...);
+	++statistics.types;
+	_types.emplace(std::move(_key), type);
+	return type;
+}
+
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
 {
 	solAssert(
@@ -306,37 +282,42 @@ Type const* TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
-	if (!m_bytesStorage)
-		m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
-	return m_bytesStorage.get();
+	unique_ptr<ArrayType>& type = instance().m_bytesStorage;
+	if (!type)
+		type = make_unique<ArrayType>(DataLocation::Storage, false);
+	return type.get();
 }
 
 ArrayType const* TypeProvider::bytesMemory()
 {
-	if (!m_bytesMemory)
-		m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
-	return m_bytesMemory.get();
+	unique_ptr<ArrayType>& type = instance().m_bytesMemory;
+	if (!type)
+		type = make_unique<ArrayType>(DataLocation::Memory, false);
+	return type.get();
 }
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
-	if (!m_bytesCalldata)
-		m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false);
-	return m_bytesCalldata.get();
+	unique_ptr<ArrayType>& type = instance().m_bytesCalldata;
+	if (!type)
+		type = make_unique<ArrayType>(DataLocation::CallData, false);
+	return type.get();
 }
 
 ArrayType const* TypeProvider::stringStorage()
 {
-	if (!m_stringStorage)
-		m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
-	return m_stringStorage.get();
+	unique_ptr<ArrayType>& type = instance().m_stringStorage;
+	if (!type)
+		type = make_unique<ArrayType>(DataLocation::Storage, true);
+	return type.get();
 }
 
 ArrayType const* TypeProvider::stringMemory()
 {
-	if (!m_stringMemory)
-		m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
-	return m_stringMemory.get();
+	unique_ptr<ArrayType>& type = instance().m_stringMemory;
+	if (!type)
+		type = make_unique<ArrayType>(DataLocation::Memory, true);
+	return type.get();
 }
 
 Type const* TypeProvider::forLiteral(Literal const& _literal)
@@ -402,9 +383,10 @@ FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPoin
 TupleType const* TypeProvider::tuple(vector<Type const*> members)
 {
 	if (members.empty())
-		return &m_emptyTuple;
+		return emptyTuple();
 
-	return createAndGet<TupleType>(std::move(members));
+	auto key = members;
+	return internAndGet(instance().m_tupleTypes, std::move(key), std::move(members));
 }
 
 ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer)
@@ -412,33 +394,49 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
+	auto& types = instance().m_locationTypes;
+	auto key = make_tuple(_type, _location, _isPointer);
+	Statistics& statistics = instance().m_statistics;
+	++statistics.requests;
+
+	auto i = types.find(key);
+	if (i != types.end())
+	{
+		++statistics.hits;
+		return i->second;
+	}
+
 	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	auto type = static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	++statistics.types;
+	types.emplace(key, type);
+	return type;
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
 {
-	return createAndGet<FunctionType>(_function, _kind);
+	return internAndGet(instance().m_nodeFunctionTypes, pair<ASTNode const*, FunctionType::Kind>(&_function, _kind), _function, _kind);
 }
 
 FunctionType const* TypeProvider::function(VariableDeclaration const& _varDecl)
 {
-	return createAndGet<FunctionType>(_varDecl);
+	return internAndGet(instance().m_nodeFunctionTypes, pair<ASTNode const*, FunctionType::Kind>(&_varDecl, FunctionType::Kind::External), _varDecl);
 }
 
 FunctionType const* TypeProvider::function(EventDefinition const& _def)
 {
-	return createAndGet<FunctionType>(_def);
+	return internAndGet(instance().m_nodeFunctionTypes, pair<ASTNode const*, FunctionType::Kind>(&_def, FunctionType::Kind::Event), _def);
 }
 
 FunctionType const* TypeProvider::function(ErrorDefinition const& _def)
 {
-	return createAndGet<FunctionType>(_def);
+	return internAndGet(instance().m_nodeFunctionTypes, pair<ASTNode const*, FunctionType::Kind>(&_def, FunctionType::Kind::Error), _def);
 }
 
 FunctionType const* TypeProvider::function(FunctionTypeName const& _typeName)
 {
-	return createAndGet<FunctionType>(_typeName);
+	// The kind only distinguishes the key from the ones of declarations.
+	return internAndGet(instance().m_nodeFunctionTypes, pair<ASTNode const*, FunctionType::Kind>(&_typeName, FunctionType::Kind::Internal), _typeName);
 }
 
 FunctionType const* TypeProvider::function(
@@ -451,7 +449,9 @@ FunctionType const* TypeProvider::function(
 {
 	// Can only use this constructor for "arbitraryParameters".
 	solAssert(!_options.valueSet && !_options.gasSet && !_options.saltSet && !_options.hasBoundFirstArgument);
-	return createAndGet<FunctionType>(
+	return internAndGet(
+		instance().m_plainFunctionTypes,
+		make_tuple(_parameterTypes, _returnParameterTypes, _kind, _stateMutability, _options.arbitraryParameters),
 		_parameterTypes,
 		_returnParameterTypes,
 		_kind,
@@ -471,7 +471,27 @@ FunctionType const* TypeProvider::function(
 	FunctionType::Options _options
 )
 {
-	return createAndGet<FunctionType>(
+	std::array<bool, 5> options{
+		_options.arbitraryParameters,
+		_options.gasSet,
+		_options.valueSet,
+		_options.saltSet,
+		_options.hasBoundFirstArgument
+	};
+	if (_declaration)
+		instance().m_functionTypeDeclarations.insert(_declaration);
+	return internAndGet(
+		instance().m_functionTypes,
+		make_tuple(
+			_parameterTypes,
+			_returnParameterTypes,
+			_parameterNames,
+			_returnParameterNames,
+			_kind,
+			_stateMutability,
+			static_cast<ASTNode const*>(_declaration),
+			options
+		),
 		_parameterTypes,
 		_returnParameterTypes,
 		_parameterNames,
@@ -485,7 +505,7 @@ FunctionType const* TypeProvider::function(
 
 RationalNumberType const* TypeProvider::rationalNumber(rational const& _value, Type const* _compatibleBytesType)
 {
-	return createAndGet<RationalNumberType>(_value, _compatibleBytesType);
+	return internAndGet(instance().m_rationalNumberTypes, make_pair(_value, _compatibleBytesType), _value, _compatibleBytesType);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
@@ -504,58 +524,74 @@ ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
 		if (_location == DataLocation::Memory)
 			return bytesMemory();
 	}
-	return createAndGet<ArrayType>(_location, _isString);
+	return internAndGet(
+		instance().m_arrayTypes,
+		make_tuple(_location, static_cast<Type const*>(nullptr), optional<u256>{}, _isString),
+		_location,
+		_isString
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType)
 {
-	return createAndGet<ArrayType>(_location, _baseType);
+	return internAndGet(
+		instance().m_arrayTypes,
+		make_tuple(_location, _baseType, optional<u256>{}, false),
+		_location,
+		_baseType
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType, u256 const& _length)
 {
-	return createAndGet<ArrayType>(_location, _baseType, _length);
+	return internAndGet(
+		instance().m_arrayTypes,
+		make_tuple(_location, _baseType, optional<u256>{_length}, false),
+		_location,
+		_baseType,
+		_length
+	);
 }
 
 ArraySliceType const* TypeProvider::arraySlice(ArrayType const& _arrayType)
 {
-	return createAndGet<ArraySliceType>(_arrayType);
+	return internAndGet(instance().m_arraySliceTypes, &_arrayType, _arrayType);
 }
 
 ContractType const* TypeProvider::contract(ContractDefinition const& _contractDef, bool _isSuper)
 {
-	return createAndGet<ContractType>(_contractDef, _isSuper);
+	return internAndGet(instance().m_contractTypes, make_pair(static_cast<ASTNode const*>(&_contractDef), _isSuper), _contractDef, _isSuper);
 }
 
 EnumType const* TypeProvider::enumType(EnumDefinition const& _enumDef)
 {
-	return createAndGet<EnumType>(_enumDef);
+	return internAndGet(instance().m_enumTypes, static_cast<ASTNode const*>(&_enumDef), _enumDef);
 }
 
 ModuleType const* TypeProvider::module(SourceUnit const& _source)
 {
-	return createAndGet<ModuleType>(_source);
+	return internAndGet(instance().m_moduleTypes, static_cast<ASTNode const*>(&_source), _source);
 }
 
 TypeType const* TypeProvider::typeType(Type const* _actualType)
 {
-	return createAndGet<TypeType>(_actualType);
+	return internAndGet(instance().m_typeTypes, _actualType, _actualType);
 }
 
 StructType const* TypeProvider::structType(StructDefinition const& _struct, DataLocation _location)
 {
-	return createAndGet<StructType>(_struct, _location);
+	return internAndGet(instance().m_structTypes, make_pair(static_cast<ASTNode const*>(&_struct), _location), _struct, _location);
 }
 
 ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
 {
-	return createAndGet<ModifierType>(_def);
+	return internAndGet(instance().m_modifierTypes, static_cast<ASTNode const*>(&_def), _def);
 }
 
 MagicType const* TypeProvider::magic(MagicType::Kind _kind)
 {
 	solAssert(_kind != MagicType::Kind::MetaType, "MetaType is handled separately");
-	return m_magics.at(static_cast<size_t>(_kind)).get();
+	return instance().m_magics.at(static_cast<size_t>(_kind)).get();
 }
 
 MagicType const* TypeProvider::meta(Type const* _type)
@@ -568,15 +604,22 @@ MagicType const* TypeProvider::meta(Type const* _type)
 		),
 		"Only enum, contracts or integer types supported for now."
 	);
-	return createAndGet<MagicType>(_type);
+	return internAndGet(instance().m_metaTypes, _type, _type);
 }
 
 MappingType const* TypeProvider::mapping(Type const* _keyType, ASTString _keyName, Type const* _valueType, ASTString _valueName)
 {
-	return createAndGet<MappingType>(_keyType, _keyName, _valueType, _valueName);
+	return internAndGet(
+		instance().m_mappingTypes,
+		make_tuple(_keyType, _keyName, _valueType, _valueName),
+		_keyType,
+		std::move(_keyName),
+		_valueType,
+		std::move(_valueName)
+	);
 }
 
 UserDefinedValueType const* TypeProvider::userDefinedValueType(UserDefinedValueTypeDefinition const& _definition)
 {
-	return createAndGet<UserDefinedValueType>(_definition);
+	return internAndGet(instance().m_userDefinedValueTypes, static_cast<ASTNode const*>(&_definition), _definition);
 }
@@ -24,7 +24,10 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -37,20 +40,61 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * Types are interned: requesting a type again with the same arguments returns the same pointer
+ * until the next reset. Types that refer to AST nodes are keyed by the address of the node.
+ * The destructor of a node removes them again, so that a node allocated later at the same
+ * address does not get the types of the destroyed one.
+ *
+ * The static functions use the instance made current on the calling thread by the innermost
+ * live Scope, or a process-wide instance if there is none. Each CompilerStack owns an instance,
+ * so that compilations on different threads do not share any type, not even the elementary
+ * ones, whose member caches depend on the compiled sources.
  */
 class TypeProvider
 {
 public:
-	TypeProvider() = default;
-	TypeProvider(TypeProvider&&) = default;
+	TypeProvider();
+	TypeProvider(TypeProvider&&) = delete;
 	TypeProvider(TypeProvider const&) = delete;
-	TypeProvider& operator=(TypeProvider&&) = default;
+	TypeProvider& operator=(TypeProvider&&) = delete;
 	TypeProvider& operator=(TypeProvider const&) = delete;
 	~TypeProvider() = default;
 
+	/// Makes a provider the current one of the calling thread while the scope is alive.
+	/// Scopes can be nested and can end in any order, but must end on the thread they began on.
+	class Scope
+	{
+	public:
+		explicit Scope(TypeProvider& _provider): m_provider(&_provider) { m_current.push_back(m_provider); }
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+		~Scope();
+
+	private:
+		TypeProvider* m_provider;
+	};
+
+	/// Numbers about the types created since the last reset.
+	struct Statistics
+	{
+		/// Number of requests for a type that is interned by its arguments.
+		size_t requests = 0;
+		/// Number of those requests that returned an already existing type.
+		size_t hits = 0;
+		/// Number of types created for those requests.
+		size_t types = 0;
+	};
+
 	/// Resets state of this TypeProvider to initial state, wiping all mutable types.
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
-	static void reset();
+	void reset();
+
+	static Statistics const& statistics() { return instance().m_statistics; }
+
+	/// Removes the interned types that refer to @a _node from the current instance.
+	/// Called by the destructor of ASTNode.
+	static void forget(ASTNode const& _node);
 
 	/// @name Factory functions
 	/// Factory functions that convert an AST @ref TypeName to a Type.
@@ -61,10 +105,10 @@ public:
 	static Type const* fromElementaryTypeName(std::string const& _name);
 
 	/// @returns boolean type.
-	static BoolType const* boolean() noexcept { return &m_boolean; }
+	static BoolType const* boolean() { return &instance().m_boolean; }
 
 	static FixedBytesType const* byte() { return fixedBytes(1); }
-	static FixedBytesType const* fixedBytes(unsigned m) { return m_bytesM.at(m - 1).get(); }
+	static FixedBytesType const* fixedBytes(unsigned m) { return instance().m_bytesM.at(m - 1).get(); }
 
 	static ArrayType const* bytesStorage();
 	static ArrayType const* bytesMemory();
@@ -83,16 +127,16 @@ public:
 
 	static ArraySliceType const* arraySlice(ArrayType const& _arrayType);
 
-	static AddressType const* payableAddress() noexcept { return &m_payableAddress; }
-	static AddressType const* address() noexcept { return &m_address; }
+	static AddressType const* payableAddress() { return &instance().m_payableAddress; }
+	static AddressType const* address() { return &instance().m_address; }
 
 	static IntegerType const* integer(unsigned _bits, IntegerType::Modifier _modifier)
 	{
 		solAssert((_bits % 8) == 0, "");
 		if (_modifier == IntegerType::Modifier::Unsigned)
-			return m_uintM.at(_bits / 8 - 1).get();
+			return instance().m_uintM.at(_bits / 8 - 1).get();
 		else
-			return m_intM.at(_bits / 8 - 1).get();
+			return instance().m_intM.at(_bits / 8 - 1).get();
 	}
 	static IntegerType const* uint(unsigned _bits) { return integer(_bits, IntegerType::Modifier::Unsigned); }
 
@@ -107,7 +151,7 @@ public:
 	/// @returns a tuple type with the given members.
 	static TupleType const* tuple(std::vector<Type const*> members);
 
-	static TupleType const* emptyTuple() noexcept { return &m_emptyTuple; }
+	static TupleType const* emptyTuple() { return &instance().m_emptyTuple; }
 
 	static ReferenceType const* withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer);
 
@@ -177,7 +221,7 @@ public:
 
 	static ContractType const* contract(ContractDefinition const& _contract, bool _isSuper = false);
 
-	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &m_inaccessibleDynamic; }
+	static InaccessibleDynamicType const* inaccessibleDynamic() { return &instance().m_inaccessibleDynamic; }
 
 	/// @returns the type of an enum instance for given definition, there is one distinct type per enum definition.
 	static EnumType const* enumType(EnumDefinition const& _enum);
@@ -200,38 +244,85 @@ public:
 	static UserDefinedValueType const* userDefinedValueType(UserDefinedValueTypeDefinition const& _definition);
 
 private:
-	/// Global TypeProvider instance.
+	/// The current TypeProvider instance of the calling thread.
 	static TypeProvider& instance()
 	{
-		static TypeProvider _provider;
-		return _provider;
+		if (!m_current.empty())
+			return *m_current.back();
+		// Never destroyed, since AST nodes may still be destroyed after the static objects.
+		static TypeProvider* provider = new TypeProvider();
+		return *provider;
 	}
 
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
-	static BoolType const m_boolean;
-	static InaccessibleDynamicType const m_inaccessibleDynamic;
-
-	/// These are lazy-initialized because they depend on `byte` being available.
-	static std::unique_ptr<ArrayType> m_bytesStorage;
-	static std::unique_ptr<ArrayType> m_bytesMemory;
-	static std::unique_ptr<ArrayType> m_bytesCalldata;
-	static std::unique_ptr<ArrayType> m_stringStorage;
-	static std::unique_ptr<ArrayType> m_stringMemory;
-
-	static TupleType const m_emptyTuple;
-	static AddressType const m_payableAddress;
-	static AddressType const m_address;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_intM;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
-	static std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
-	static std::array<std::unique_ptr<MagicType>, 4> const m_magics;        ///< MagicType's except MetaType
+	/// @returns the type stored in @a _types under @a _key, after creating it from @a _args
+	/// with createAndGet if it does not exist yet.
+	template <typename T, typename Key, typename... Args>
+	static inline T const* internAndGet(std::map<Key, T const*>& _types, Key _key, Args&& ... _args);
+
+	/// The instances made current by the live scopes of this thread, innermost last.
+	static thread_local std::vector<TypeProvider*> m_current;
+
+	BoolType const m_boolean{};
+	InaccessibleDynamicType const m_inaccessibleDynamic{};
+
+	/// These are lazy-initialized because they depend on `byte` being available
+	/// from the current instance.
+	std::unique_ptr<ArrayType> m_bytesStorage;
+	std::unique_ptr<ArrayType> m_bytesMemory;
+	std::unique_ptr<ArrayType> m_bytesCalldata;
+	std::unique_ptr<ArrayType> m_stringStorage;
+	std::unique_ptr<ArrayType> m_stringMemory;
+
+	TupleType const m_emptyTuple{};
+	AddressType const m_payableAddress{StateMutability::Payable};
+	AddressType const m_address{StateMutability::NonPayable};
+	std::array<std::unique_ptr<IntegerType>, 32> m_intM;
+	std::array<std::unique_ptr<IntegerType>, 32> m_uintM;
+	std::array<std::unique_ptr<FixedBytesType>, 32> m_bytesM;
+	std::array<std::unique_ptr<MagicType>, 4> m_magics;        ///< MagicType's except MetaType
 
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+
+	/// Interned types, keyed by the arguments they are created from.
+	/// They are owned by m_generalTypes. AST nodes are keyed as ASTNode pointers,
+	/// which are the addresses forget is called with.
+	//@{
+	std::map<std::vector<Type const*>, TupleType const*> m_tupleTypes{};
+	std::map<std::tuple<ReferenceType const*, DataLocation, bool>, ReferenceType const*> m_locationTypes{};
+	/// Function types created from a declaration or function type name, keyed by the node and the kind.
+	std::map<std::pair<ASTNode const*, FunctionType::Kind>, FunctionType const*> m_nodeFunctionTypes{};
+	std::map<
+		std::tuple<strings, strings, FunctionType::Kind, StateMutability, bool>,
+		FunctionType const*
+	> m_plainFunctionTypes{};
+	std::map<
+		std::tuple<TypePointers, TypePointers, strings, strings, FunctionType::Kind, StateMutability, ASTNode const*, std::array<bool, 5>>,
+		FunctionType const*
+	> m_functionTypes{};
+	/// The declarations that are part of a key of m_functionTypes.
+	std::set<ASTNode const*> m_functionTypeDeclarations{};
+	std::map<std::pair<rational, Type const*>, RationalNumberType const*> m_rationalNumberTypes{};
+	/// Array types keyed by location, base type (null for bytes and string), length (unset if dynamic) and whether it is a string.
+	std::map<std::tuple<DataLocation, Type const*, std::optional<u256>, bool>, ArrayType const*> m_arrayTypes{};
+	std::map<ArrayType const*, ArraySliceType const*> m_arraySliceTypes{};
+	std::map<std::pair<ASTNode const*, bool>, ContractType const*> m_contractTypes{};
+	std::map<ASTNode const*, EnumType const*> m_enumTypes{};
+	std::map<ASTNode const*, ModuleType const*> m_moduleTypes{};
+	std::map<Type const*, TypeType const*> m_typeTypes{};
+	std::map<std::pair<ASTNode const*, DataLocation>, StructType const*> m_structTypes{};
+	std::map<ASTNode const*, ModifierType const*> m_modifierTypes{};
+	std::map<Type const*, MagicType const*> m_metaTypes{};
+	std::map<std::tuple<Type const*, ASTString, Type const*, ASTString>, MappingType const*> m_mappingTypes{};
+	std::map<ASTNode const*, UserDefinedValueType const*> m_userDefinedValueTypes{};
+	//@}
+
+	Statistics m_statistics{};
 };
 
 }
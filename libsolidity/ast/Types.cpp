@@ -1689,6 +1689,8 @@ string ArrayType::richIdentifier() const
 
 bool ArrayType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
@@ -3092,6 +3094,8 @@ string FunctionType::richIdentifier() const
 
 bool FunctionType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	FunctionType const& other = dynamic_cast<FunctionType const&>(_other);
@@ -3795,6 +3799,8 @@ string MappingType::richIdentifier() const
 
 bool MappingType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	MappingType const& other = dynamic_cast<MappingType const&>(_other);
@@ -3846,6 +3852,8 @@ string TypeType::richIdentifier() const
 
 bool TypeType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	TypeType const& other = dynamic_cast<TypeType const&>(_other);
@@ -4015,6 +4023,8 @@ string ModifierType::richIdentifier() const
 
 bool ModifierType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ModifierType const& other = dynamic_cast<ModifierType const&>(_other);
@@ -218,6 +218,8 @@ public:
 		return TokenTraits::isCompareOp(_operator) ? commonType(this, _other) : nullptr;
 	}
 
+	/// TypeProvider returns the same pointer when a type is requested again with the same
+	/// arguments, so the overrides for compound types compare the pointers first.
 	virtual bool operator==(Type const& _other) const { return category() == _other.category(); }
 	virtual bool operator!=(Type const& _other) const { return !this->operator ==(_other); }
 
@@ -26,17 +26,20 @@ using namespace solidity::smtutil;
 using namespace solidity::frontend;
 using namespace solidity::frontend::smt;
 
-map<string, ArraySlicePredicate::SliceData> ArraySlicePredicate::m_slicePredicates;
-
-pair<bool, ArraySlicePredicate::SliceData const&> ArraySlicePredicate::create(SortPointer _sort, EncodingContext& _context)
+pair<bool, ArraySlicePredicate::SliceData const&> ArraySlicePredicate::create(
+	SortPointer _sort,
+	EncodingContext& _context,
+	Predicate::Registry& _predicates,
+	Registry& _slices
+)
 {
 	solAssert(_sort->kind == Kind::Tuple, "");
 	auto tupleSort = dynamic_pointer_cast<TupleSort>(_sort);
 	solAssert(tupleSort, "");
 
 	auto tupleName = tupleSort->name;
-	if (m_slicePredicates.count(tupleName))
-		return {true, m_slicePredicates.at(tupleName)};
+	if (_slices.count(tupleName))
+		return {true, _slices.at(tupleName)};
 
 	auto sort = tupleSort->components.at(0);
 	solAssert(sort->kind == Kind::Array, "");
@@ -49,12 +52,12 @@ pair<bool, ArraySlicePredicate::SliceData const&> ArraySlicePredicate::create(So
 
 	vector<SortPointer> domain{sort, sort, startVar.sort(), endVar.sort()};
 	auto sliceSort = make_shared<FunctionSort>(domain, SortProvider::boolSort);
-	Predicate const& slice = *Predicate::create(sliceSort, "array_slice_" + tupleName, PredicateType::Custom, _context);
+	Predicate const& slice = *Predicate::create(sliceSort, "array_slice_" + tupleName, PredicateType::Custom, _context, _predicates);
 
 	domain.emplace_back(iVar.sort());
 	auto predSort = make_shared<FunctionSort>(domain, SortProvider::boolSort);
-	Predicate const& header = *Predicate::create(predSort, "array_slice_header_" + tupleName, PredicateType::Custom, _context);
-	Predicate const& loop = *Predicate::create(predSort, "array_slice_loop_" + tupleName, PredicateType::Custom, _context);
+	Predicate const& header = *Predicate::create(predSort, "array_slice_header_" + tupleName, PredicateType::Custom, _context, _predicates);
+	Predicate const& loop = *Predicate::create(predSort, "array_slice_loop_" + tupleName, PredicateType::Custom, _context, _predicates);
 
 	auto a = aVar.elements();
 	auto b = bVar.elements();
@@ -84,7 +87,7 @@ pair<bool, ArraySlicePredicate::SliceData const&> ArraySlicePredicate::create(So
 		header({a, b, start, end, i + 1})
 	);
 
-	return {false, m_slicePredicates[tupleName] = {
+	return {false, _slices[tupleName] = {
 		{&slice, &header, &loop},
 		{std::move(rule1), std::move(rule2), std::move(rule3), std::move(rule4)}
 	}};
@@ -48,15 +48,18 @@ struct ArraySlicePredicate
 		std::vector<smtutil::Expression> rules;
 	};
 
+	/// Maps a unique sort name to its slice data.
+	using Registry = std::map<std::string, SliceData>;
+
 	/// @returns a flag representing whether the array slice predicates had already been created before for this sort,
 	/// and the corresponding slice data.
-	static std::pair<bool, SliceData const&> create(smtutil::SortPointer _sort, smt::EncodingContext& _context);
-
-	static void reset() { m_slicePredicates.clear(); }
-
-private:
-	/// Maps a unique sort name to its slice data.
-	static std::map<std::string, SliceData> m_slicePredicates;
+	/// The slice data is stored in @a _slices and its predicates in @a _predicates.
+	static std::pair<bool, SliceData const&> create(
+		smtutil::SortPointer _sort,
+		smt::EncodingContext& _context,
+		Predicate::Registry& _predicates,
+		Registry& _slices
+	);
 };
 
 }
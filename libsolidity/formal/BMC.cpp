@@ -42,11 +42,22 @@ BMC::BMC(
 	map<h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	ModelCheckerTargetCallback _onTargetChecked
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout))
+	m_interface(make_unique<smtutil::SMTPortfolio>(
+		_smtlib2Responses,
+		_smtCallback,
+		_settings.solvers,
+		_settings.timeout,
+		_settings.portfolio.mode,
+		_settings.cacheDirectory ? make_shared<smtutil::SMTQueryCache>(*_settings.cacheDirectory) : nullptr
+	)),
+	m_incremental(_settings.incremental && !_settings.solvers.smtlib2),
+	m_onTargetChecked(std::move(_onTargetChecked))
 {
+	m_interface->setCountAssertedNodes(m_settings.statistics);
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (m_settings.solvers.cvc4 || m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -142,6 +153,7 @@ bool BMC::shouldInlineFunctionCall(
 bool BMC::visit(ContractDefinition const& _contract)
 {
 	initContract(_contract);
+	pushSharedAssertions();
 
 	SMTEncoder::visit(_contract);
 
@@ -163,6 +175,7 @@ void BMC::endVisit(ContractDefinition const& _contract)
 		m_verificationTargets.clear();
 	}
 
+	popSharedAssertions();
 	SMTEncoder::endVisit(_contract);
 }
 
@@ -184,6 +197,7 @@ bool BMC::visit(FunctionDefinition const& _function)
 		if (_function.isConstructor() || _function.isPublic())
 			m_context.addAssertion(state().txTypeConstraints() && state().txFunctionConstraints(_function));
 		resetStateVariables();
+		pushSharedAssertions();
 	}
 
 	if (_function.isConstructor())
@@ -209,6 +223,7 @@ void BMC::endVisit(FunctionDefinition const& _function)
 		checkVerificationTargets();
 		m_verificationTargets.clear();
 		m_pathConditions.clear();
+		popSharedAssertions();
 	}
 
 	SMTEncoder::endVisit(_function);
@@ -696,8 +711,33 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets()
 {
+	// The SMT callback must not be called concurrently.
+	if (m_settings.threads > 1 && !m_settings.solvers.smtlib2)
+		solveVerificationTargetsInParallel();
+
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target);
+
+	solAssert(m_parallelResults.empty(), "");
+}
+
+void BMC::solveVerificationTargetsInParallel()
+{
+	solAssert(!m_parallelQueries && m_parallelResults.empty(), "");
+
+	// Run the checks once only to collect the queries they would solve,
+	// in the order they are later going to be reported in.
+	// Constant conditions are solved on the main solver, so they are skipped here and
+	// only checked once in the reporting pass.
+	vector<smtutil::SMTPortfolio::ParallelQuery> queries;
+	m_parallelQueries = &queries;
+	for (auto& target: m_verificationTargets)
+		if (target.type != VerificationTargetType::ConstantCondition)
+			checkVerificationTarget(target);
+	m_parallelQueries = nullptr;
+
+	for (auto& result: m_interface->checkInParallel(queries, m_settings.threads))
+		m_parallelResults.emplace_back(std::move(result));
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -762,10 +802,8 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
-		_target.constraints && _target.value < smt::minValue(*intType),
-		_target.callStack,
-		_target.modelExpressions,
-		_target.expression->location(),
+		_target,
+		_target.value < smt::minValue(*intType),
 		4144_error,
 		8312_error,
 		"Underflow (resulting value less than " + formatNumberReadable(intType->minValue()) + ")",
@@ -795,10 +833,8 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
-		_target.constraints && _target.value > smt::maxValue(*intType),
-		_target.callStack,
-		_target.modelExpressions,
-		_target.expression->location(),
+		_target,
+		_target.value > smt::maxValue(*intType),
 		2661_error,
 		8065_error,
 		"Overflow (resulting value larger than " + formatNumberReadable(intType->maxValue()) + ")",
@@ -818,10 +854,8 @@ void BMC::checkDivByZero(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
-		_target.constraints && (_target.value == 0),
-		_target.callStack,
-		_target.modelExpressions,
-		_target.expression->location(),
+		_target,
+		(_target.value == 0),
 		3046_error,
 		5272_error,
 		"Division by zero",
@@ -834,10 +868,8 @@ void BMC::checkBalance(BMCVerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTargetType::Balance, "");
 	checkCondition(
-		_target.constraints && _target.value,
-		_target.callStack,
-		_target.modelExpressions,
-		_target.expression->location(),
+		_target,
+		_target.value,
 		1236_error,
 		4010_error,
 		"Insufficient funds",
@@ -856,10 +888,8 @@ void BMC::checkAssert(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
-		_target.constraints && !_target.value,
-		_target.callStack,
-		_target.modelExpressions,
-		_target.expression->location(),
+		_target,
+		!_target.value,
 		4661_error,
 		7812_error,
 		"Assertion violation"
@@ -883,7 +913,8 @@ void BMC::addVerificationTarget(
 		},
 		_expression,
 		m_callStack,
-		modelExpressions()
+		modelExpressions(),
+		currentPathConditions()
 	};
 	if (_type == VerificationTargetType::ConstantCondition)
 		checkVerificationTarget(target);
@@ -894,10 +925,8 @@ void BMC::addVerificationTarget(
 /// Solving.
 
 void BMC::checkCondition(
-	smtutil::Expression _condition,
-	vector<SMTEncoder::CallStackEntry> const& _callStack,
-	pair<vector<smtutil::Expression>, vector<string>> const& _modelExpressions,
-	SourceLocation const& _location,
+	BMCVerificationTarget const& _target,
+	smtutil::Expression const& _condition,
 	ErrorId _errorHappens,
 	ErrorId _errorMightHappen,
 	string const& _description,
@@ -905,21 +934,82 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
+	vector<CallStackEntry> const& callStack = _target.callStack;
+	SourceLocation const& location = _target.expression->location();
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
-	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
-	if (_callStack.size())
+	tie(expressionsToEvaluate, expressionNames) = _target.modelExpressions;
+	if (callStack.size())
 		if (_additionalValue)
 		{
 			expressionsToEvaluate.emplace_back(*_additionalValue);
 			expressionNames.push_back(_additionalValueName);
 		}
+
+	bool const solvedInParallel = !m_parallelResults.empty();
+	smtutil::Expression query = _target.constraints && _condition;
+	// The queries solved in parallel do not see the assertions of the solver, and must be
+	// sliced the same way when they are collected and when their results are taken.
+	if (m_parallelQueries || solvedInParallel)
+		query = withSharedAssertions(std::move(query));
+
+	// The sliced query is implied by the whole query, so if it is unsatisfiable the target is safe.
+	// Otherwise the whole query is checked, both to avoid false positives caused by the
+	// constraints that were sliced away and to get a complete counterexample.
+	optional<smtutil::Expression> slicedQuery;
+	if (m_settings.sliceQueries)
+	{
+		smtutil::SlicingStatistics statistics;
+		smtutil::Expression sliced = smtutil::coneOfInfluence(query, {_target.pathConditions, _condition}, statistics);
+		if (statistics.keptConjuncts < statistics.conjuncts)
+			slicedQuery = std::move(sliced);
+		// The queries solved in parallel were counted when they were collected.
+		if (!solvedInParallel)
+			m_slicingStatistics += statistics;
+	}
+
+	if (m_parallelQueries)
+	{
+		// The whole query is solved as well, since it is needed if the sliced query is satisfiable.
+		if (slicedQuery)
+			m_parallelQueries->push_back({std::move(*slicedQuery), {}});
+		m_parallelQueries->push_back({std::move(query), std::move(expressionsToEvaluate)});
+		return;
+	}
+
 	smtutil::CheckResult result;
 	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	smtutil::SMTPortfolio::QueryStatistics queryStatistics;
+	if (slicedQuery)
+	{
+		if (!solvedInParallel)
+		{
+			m_interface->push();
+			m_interface->addAssertion(*slicedQuery);
+		}
+		result = checkSatisfiableAndGenerateModel({}, solvedInParallel).first;
+		if (!solvedInParallel)
+			m_interface->pop();
+		queryStatistics = m_lastQuery;
+	}
+	if (!slicedQuery || result != smtutil::CheckResult::UNSATISFIABLE)
+	{
+		if (!solvedInParallel)
+		{
+			m_interface->push();
+			m_interface->addAssertion(query);
+		}
+		tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate, solvedInParallel);
+		if (!solvedInParallel)
+			m_interface->pop();
+		auto slicedTime = queryStatistics.time;
+		queryStatistics = m_lastQuery;
+		queryStatistics.time += slicedTime;
+	}
+	else if (solvedInParallel)
+		// The answer to the whole query is not needed.
+		m_parallelResults.pop_front();
+	targetChecked(_target.type, location, callStack, result, queryStatistics);
 
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -940,7 +1030,7 @@ void BMC::checkCondition(
 	{
 	case smtutil::CheckResult::SATISFIABLE:
 	{
-		solAssert(!_callStack.empty(), "");
+		solAssert(!callStack.empty(), "");
 		std::ostringstream message;
 		message << "BMC: " << _description << " happens here.";
 
@@ -960,10 +1050,10 @@ void BMC::checkCondition(
 
 		m_errorReporter.warning(
 			_errorHappens,
-			_location,
+			location,
 			message.str(),
 			SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
-			.append(SMTEncoder::callStackMessage(_callStack))
+			.append(SMTEncoder::callStackMessage(callStack))
 			.append(std::move(secondaryLocation))
 		);
 		break;
@@ -974,18 +1064,16 @@ void BMC::checkCondition(
 	{
 		++m_unprovedAmt;
 		if (m_settings.showUnproved)
-			m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
+			m_errorReporter.warning(_errorMightHappen, location, "BMC: " + _description + " might happen here.", secondaryLocation);
 		break;
 	}
 	case smtutil::CheckResult::CONFLICTING:
-		m_errorReporter.warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		m_errorReporter.warning(1584_error, location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smtutil::CheckResult::ERROR:
-		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
+		m_errorReporter.warning(1823_error, location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -998,17 +1086,40 @@ void BMC::checkBooleanNotConstant(
 	// Do not check for const-ness if this is a constant.
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
+	// These queries are not part of the ones solved in parallel.
+	solAssert(!m_parallelQueries, "");
 
 	m_interface->push();
 	m_interface->addAssertion(_constraints && _value);
 	auto positiveResult = checkSatisfiable();
 	m_interface->pop();
+	auto positiveTime = m_lastQuery.time;
 
 	m_interface->push();
 	m_interface->addAssertion(_constraints && !_value);
 	auto negatedResult = checkSatisfiable();
 	m_interface->pop();
 
+	if (m_onTargetChecked)
+	{
+		// The target is safe if the condition can be both true and false,
+		// and unsafe if a warning is reported.
+		smtutil::CheckResult result = smtutil::CheckResult::SATISFIABLE;
+		for (auto oneResult: {positiveResult, negatedResult})
+			if (oneResult == smtutil::CheckResult::ERROR || oneResult == smtutil::CheckResult::CONFLICTING)
+				result = oneResult;
+		if (result == smtutil::CheckResult::SATISFIABLE)
+		{
+			if (positiveResult == smtutil::CheckResult::SATISFIABLE && negatedResult == smtutil::CheckResult::SATISFIABLE)
+				result = smtutil::CheckResult::UNSATISFIABLE;
+			else if (positiveResult == smtutil::CheckResult::UNKNOWN || negatedResult == smtutil::CheckResult::UNKNOWN)
+				result = smtutil::CheckResult::UNKNOWN;
+		}
+		auto queryStatistics = m_lastQuery;
+		queryStatistics.time += positiveTime;
+		targetChecked(VerificationTargetType::ConstantCondition, _condition.location(), _callStack, result, queryStatistics);
+	}
+
 	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
 		m_errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
 	else if (positiveResult == smtutil::CheckResult::CONFLICTING || negatedResult == smtutil::CheckResult::CONFLICTING)
@@ -1047,13 +1158,29 @@ void BMC::checkBooleanNotConstant(
 }
 
 pair<smtutil::CheckResult, vector<string>>
-BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
+BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate, bool _solvedInParallel)
 {
 	smtutil::CheckResult result;
 	vector<string> values;
+	m_lastQuery = {};
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		if (!_solvedInParallel)
+		{
+			tie(result, values) = m_interface->check(_expressionsToEvaluate);
+			m_lastQuery = m_interface->lastQuery();
+		}
+		else
+		{
+			solAssert(!m_parallelResults.empty(), "");
+			auto solved = std::move(m_parallelResults.front());
+			m_parallelResults.pop_front();
+			if (solved.error)
+				rethrow_exception(solved.error);
+			result = solved.result;
+			values = std::move(solved.values);
+			m_lastQuery = std::move(solved.statistics);
+		}
 	}
 	catch (smtutil::SolverError const& _e)
 	{
@@ -1079,7 +1206,69 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 
 smtutil::CheckResult BMC::checkSatisfiable()
 {
-	return checkSatisfiableAndGenerateModel({}).first;
+	return checkSatisfiableAndGenerateModel({}, false).first;
+}
+
+void BMC::pushSharedAssertions()
+{
+	if (!m_incremental)
+		return;
+
+	smtutil::Expression shared = m_context.assertions();
+	m_interface->push();
+	m_interface->addAssertion(shared);
+	m_sharedAssertions.emplace_back(std::move(shared));
+
+	// Start a new level of the context with no constraints instead of a copy of the current ones.
+	m_context.setAssertionAccumulation(false);
+	m_context.pushSolver();
+	m_context.setAssertionAccumulation(true);
+}
+
+void BMC::popSharedAssertions()
+{
+	if (!m_incremental)
+		return;
+
+	solAssert(!m_sharedAssertions.empty(), "");
+	m_context.popSolver();
+	m_interface->pop();
+	m_sharedAssertions.pop_back();
+}
+
+smtutil::Expression BMC::withSharedAssertions(smtutil::Expression _query) const
+{
+	for (auto shared = m_sharedAssertions.rbegin(); shared != m_sharedAssertions.rend(); ++shared)
+		_query = *shared && std::move(_query);
+	return _query;
+}
+
+void BMC::targetChecked(
+	VerificationTargetType _type,
+	SourceLocation const& _location,
+	vector<CallStackEntry> const& _callStack,
+	smtutil::CheckResult _result,
+	smtutil::SMTPortfolio::QueryStatistics const& _query
+)
+{
+	if (!m_onTargetChecked)
+		return;
+
+	ModelCheckerTargetStatistics statistics;
+	statistics.engine = "BMC";
+	statistics.type = _type;
+	statistics.location = _location;
+	statistics.function = ModelCheckerTargetStatistics::functionName(
+		m_currentContract,
+		_callStack.empty() ? nullptr : _callStack.front().first
+	);
+	statistics.solver = _query.solver;
+	statistics.queryBytes = _query.queryBytes;
+	statistics.time = _query.time;
+	statistics.result = _result;
+	if (_result == smtutil::CheckResult::UNKNOWN)
+		statistics.unknownReason = _query.unknownReason;
+	m_onTargetChecked(statistics);
 }
 
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
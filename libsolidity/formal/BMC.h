@@ -31,13 +31,17 @@
 
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/ConeOfInfluence.h>
+#include <libsmtutil/SMTPortfolio.h>
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
+#include <deque>
 #include <set>
 #include <string>
 #include <vector>
@@ -63,7 +67,8 @@ public:
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		ModelCheckerTargetCallback _onTargetChecked = {}
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> _solvedTargets);
@@ -73,6 +78,15 @@ public:
 	/// the constructor.
 	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
 
+	/// @returns the counters of the solvers used so far, keyed by solver name.
+	std::map<std::string, smtutil::SMTPortfolio::SolverStatistics> const& solverStatistics() const
+	{
+		return m_interface->statistics();
+	}
+
+	/// @returns the sizes of the queries before and after slicing.
+	smtutil::SlicingStatistics const& slicingStatistics() const { return m_slicingStatistics; }
+
 	/// @returns true if _funCall should be inlined, otherwise false.
 	/// @param _scopeContract The contract that contains the current function being analyzed.
 	/// @param _contextContract The most derived contract, currently being analyzed.
@@ -135,9 +149,14 @@ private:
 		Expression const* expression;
 		std::vector<CallStackEntry> callStack;
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions;
+		/// The path conditions that are part of the constraints, from which slicing starts.
+		smtutil::Expression pathConditions;
 	};
 
 	void checkVerificationTargets();
+	/// Collects the queries of m_verificationTargets and solves them in parallel,
+	/// storing the results in m_parallelResults.
+	void solveVerificationTargetsInParallel();
 	void checkVerificationTarget(BMCVerificationTarget& _target);
 	void checkConstantCondition(BMCVerificationTarget& _target);
 	void checkUnderflow(BMCVerificationTarget& _target);
@@ -154,12 +173,10 @@ private:
 
 	/// Solver related.
 	//@{
-	/// Check that a condition can be satisfied.
+	/// Check that a condition can be satisfied together with the constraints of @a _target.
 	void checkCondition(
-		smtutil::Expression _condition,
-		std::vector<CallStackEntry> const& _callStack,
-		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> const& _modelExpressions,
-		langutil::SourceLocation const& _location,
+		BMCVerificationTarget const& _target,
+		smtutil::Expression const& _condition,
 		langutil::ErrorId _errorHappens,
 		langutil::ErrorId _errorMightHappen,
 		std::string const& _description,
@@ -174,13 +191,37 @@ private:
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
+	/// Checks the current assertions, or takes the next result from m_parallelResults if @a _solvedInParallel.
+	/// Stores the solver, size and time of the query in m_lastQuery.
 	std::pair<smtutil::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate, bool _solvedInParallel);
+	/// If incremental solving is enabled, asserts the current constraints in the solver
+	/// in a new scope and continues with an empty set of constraints in the encoding context.
+	void pushSharedAssertions();
+	/// Removes the constraints asserted by the matching pushSharedAssertions.
+	void popSharedAssertions();
+	/// @returns the conjunction of the constraints asserted by pushSharedAssertions
+	/// followed by @a _query, which is returned unchanged if there are none.
+	smtutil::Expression withSharedAssertions(smtutil::Expression _query) const;
+
+	/// Passes the outcome of checking a target to m_onTargetChecked, if set.
+	void targetChecked(
+		VerificationTargetType _type,
+		langutil::SourceLocation const& _location,
+		std::vector<CallStackEntry> const& _callStack,
+		smtutil::CheckResult _result,
+		smtutil::SMTPortfolio::QueryStatistics const& _query
+	);
 
 	smtutil::CheckResult checkSatisfiable();
 	//@}
 
-	std::unique_ptr<smtutil::SolverInterface> m_interface;
+	std::unique_ptr<smtutil::SMTPortfolio> m_interface;
+
+	/// If not null, checkCondition only appends its query here instead of solving it.
+	std::vector<smtutil::SMTPortfolio::ParallelQuery>* m_parallelQueries = nullptr;
+	/// Results of queries solved in parallel, in the order checkCondition asks for them.
+	std::deque<smtutil::SMTPortfolio::ParallelResult> m_parallelResults;
 
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
@@ -193,6 +234,21 @@ private:
 
 	/// Number of verification conditions that could not be proved.
 	size_t m_unprovedAmt = 0;
+
+	/// Sizes of the queries before and after slicing, if enabled.
+	smtutil::SlicingStatistics m_slicingStatistics;
+
+	/// Whether the constraints shared by the queries of a contract and of a function
+	/// are asserted in the solver once. The SMT-LIB2 interface resends the whole query
+	/// and forgets the declarations made inside a popped scope, so it is not used there.
+	bool const m_incremental;
+	/// The constraints asserted in the solver by pushSharedAssertions, outermost first.
+	std::vector<smtutil::Expression> m_sharedAssertions;
+
+	/// The solver, size and time of the last query checked by checkSatisfiableAndGenerateModel.
+	smtutil::SMTPortfolio::QueryStatistics m_lastQuery;
+
+	ModelCheckerTargetCallback m_onTargetChecked;
 };
 
 }
@@ -24,7 +24,6 @@
 #include <libsmtutil/Z3CHCInterface.h>
 #endif
 
-#include <libsolidity/formal/ArraySlicePredicate.h>
 #include <libsolidity/formal/Invariants.h>
 #include <libsolidity/formal/PredicateInstance.h>
 #include <libsolidity/formal/PredicateSort.h>
@@ -49,6 +48,7 @@
 #include <range/v3/view/reverse.hpp>
 
 #include <charconv>
+#include <chrono>
 #include <queue>
 
 using namespace std;
@@ -65,9 +65,11 @@ CHC::CHC(
 	map<util::h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	ModelCheckerTargetCallback _onTargetChecked
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
+	m_onTargetChecked(std::move(_onTargetChecked)),
 	m_smtlib2Responses(_smtlib2Responses),
 	m_smtCallback(_smtCallback)
 {
@@ -624,7 +626,7 @@ void CHC::endVisit(IndexRangeAccess const& _range)
 	auto sliceArray = dynamic_pointer_cast<SymbolicArrayVariable>(m_context.expression(_range));
 	solAssert(baseArray && sliceArray, "");
 
-	auto const& sliceData = ArraySlicePredicate::create(sliceArray->sort(), m_context);
+	auto const& sliceData = ArraySlicePredicate::create(sliceArray->sort(), m_context, m_predicates, m_arraySlices);
 	if (!sliceData.first)
 	{
 		for (auto pred: sliceData.second.predicates)
@@ -1159,8 +1161,8 @@ void CHC::resetSourceAnalysis()
 	m_nondetInterfaces.clear();
 	m_constructorSummaries.clear();
 	m_contractInitializers.clear();
-	Predicate::reset();
-	ArraySlicePredicate::reset();
+	m_predicates.clear();
+	m_arraySlices.clear();
 	m_blockCounter = 0;
 
 	// At this point every enabled solver is available.
@@ -1170,7 +1172,10 @@ void CHC::resetSourceAnalysis()
 	{
 #ifdef HAVE_Z3
 		// z3::fixedpoint does not have a reset mechanism, so we need to create another.
-		m_interface = std::make_unique<Z3CHCInterface>(m_settings.timeout);
+		m_interface = std::make_unique<Z3CHCInterface>(
+			m_settings.timeout,
+			m_settings.cacheDirectory ? make_shared<SMTQueryCache>(*m_settings.cacheDirectory) : nullptr
+		);
 		auto z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
 		solAssert(z3Interface, "");
 		m_context.setSolver(z3Interface->z3Interface());
@@ -1183,7 +1188,13 @@ void CHC::resetSourceAnalysis()
 		solAssert(m_settings.solvers.smtlib2 || m_settings.solvers.eld);
 
 		if (!m_interface)
-			m_interface = make_unique<CHCSmtLib2Interface>(m_smtlib2Responses, m_smtCallback, m_settings.solvers, m_settings.timeout);
+			m_interface = make_unique<CHCSmtLib2Interface>(
+				m_smtlib2Responses,
+				m_smtCallback,
+				m_settings.solvers,
+				m_settings.timeout,
+				m_settings.cacheDirectory ? make_shared<SMTQueryCache>(*m_settings.cacheDirectory) : nullptr
+			);
 
 		auto smtlib2Interface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
 		solAssert(smtlib2Interface, "");
@@ -1320,7 +1331,7 @@ SortPointer CHC::sort(ASTNode const* _node)
 
 Predicate const* CHC::createSymbolicBlock(SortPointer _sort, string const& _name, PredicateType _predType, ASTNode const* _node, ContractDefinition const* _contractContext)
 {
-	auto const* block = Predicate::create(_sort, _name, _predType, m_context, _node, _contractContext, m_scopes);
+	auto const* block = Predicate::create(_sort, _name, _predType, m_context, m_predicates, _node, _contractContext, m_scopes);
 	m_interface->registerRelation(block->functor());
 	return block;
 }
@@ -1799,38 +1810,48 @@ tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query
 	CheckResult result;
 	smtutil::Expression invariant(true);
 	CHCSolverInterface::CexGraph cex;
-	tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
-	{
+	auto start = chrono::steady_clock::now();
 	// We still need the ifdef because of Z3CHCInterface.
-		if (m_settings.solvers.z3)
-		{
+	if (m_settings.solvers.z3)
+	{
 #ifdef HAVE_Z3
-			// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
-			// We now disable those optimizations and check whether we can still solve the problem.
-			auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
-			solAssert(spacer, "");
-			spacer->setSpacerOptions(false);
-
-			CheckResult resultNoOpt;
-			smtutil::Expression invariantNoOpt(true);
-			CHCSolverInterface::CexGraph cexNoOpt;
-			tie(resultNoOpt, invariantNoOpt, cexNoOpt) = m_interface->query(_query);
-
-			if (resultNoOpt == CheckResult::SATISFIABLE)
-				cex = std::move(cexNoOpt);
-
-			spacer->setSpacerOptions(true);
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+		solAssert(spacer, "");
+		tie(result, invariant, cex) = spacer->queryWithCounterexample(_query);
 #else
-			solAssert(false);
+		solAssert(false);
 #endif
-		}
-		break;
 	}
+	else
+		tie(result, invariant, cex) = m_interface->query(_query);
+
+	auto& statistics = m_solverStatistics[solverName()];
+	++statistics.queries;
+	if (result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE)
+		++statistics.answers;
+	statistics.time += chrono::steady_clock::now() - start;
+	if (auto const* smtlib2 = dynamic_cast<CHCSmtLib2Interface const*>(m_interface.get()))
+	{
+		statistics.queryBytes += smtlib2->lastQuerySize();
+		statistics.largestQueryBytes = max(statistics.largestQueryBytes, smtlib2->lastQuerySize());
+	}
+	reportSolverError(result, _location);
+	return {result, invariant, cex};
+}
+
+string CHC::solverName() const
+{
+	if (m_settings.solvers.z3)
+		return "z3";
+	return m_settings.solvers.eld ? "eld" : "smtlib2";
+}
+
+void CHC::reportSolverError(CheckResult _result, SourceLocation const& _location)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
 	case CheckResult::UNSATISFIABLE:
-		break;
 	case CheckResult::UNKNOWN:
 		break;
 	case CheckResult::CONFLICTING:
@@ -1840,7 +1861,6 @@ tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
 		break;
 	}
-	return {result, invariant, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -1858,7 +1878,8 @@ void CHC::verificationTargetEncountered(
 	bool scopeIsFunction = m_currentFunction && !m_currentFunction->isConstructor();
 	auto errorId = newErrorId();
 	solAssert(m_verificationTargets.count(errorId) == 0, "Error ID is not unique!");
-	m_verificationTargets.emplace(errorId, CHCVerificationTarget{{_type, _errorCondition, smtutil::Expression(true)}, errorId, _errorNode});
+	string function = m_onTargetChecked ? ModelCheckerTargetStatistics::functionName(m_currentContract, m_currentFunction) : "";
+	m_verificationTargets.emplace(errorId, CHCVerificationTarget{{_type, _errorCondition, smtutil::Expression(true)}, errorId, _errorNode, std::move(function)});
 	if (scopeIsFunction)
 		m_functionTargetIds[m_currentFunction].push_back(errorId);
 	else
@@ -1897,6 +1918,10 @@ void CHC::checkVerificationTargets()
 				targetEntryPoints[id].push_back(placeholder);
 	}
 
+	// Only the Horn solver linked into the compiler can solve queries in parallel.
+	if (m_settings.threads > 1 && m_settings.solvers.z3)
+		solveVerificationTargetsInParallel(targetEntryPoints);
+
 	set<unsigned> checkedErrorIds;
 	for (auto const& [targetId, placeholders]: targetEntryPoints)
 	{
@@ -1955,6 +1980,7 @@ void CHC::checkVerificationTargets()
 		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
 		checkedErrorIds.insert(target.errorId);
 	}
+	solAssert(m_parallelResults.empty(), "");
 
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
@@ -2043,6 +2069,52 @@ void CHC::checkVerificationTargets()
 		m_safeTargets[m_verificationTargets.at(id).errorNode].insert(m_verificationTargets.at(id).type);
 }
 
+void CHC::solveVerificationTargetsInParallel(map<unsigned, vector<CHCQueryPlaceholder>> const& _targetEntryPoints)
+{
+#ifdef HAVE_Z3
+	solAssert(m_parallelResults.empty(), "");
+	auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+	solAssert(spacer, "");
+
+	// The queries of all targets are encoded before any of them is solved, so targets that
+	// are skipped later because an earlier target already reported their node are solved too.
+	vector<smtutil::Expression> queries;
+	for (auto const& [targetId, placeholders]: _targetEntryPoints)
+		queries.emplace_back(encodeTargetQuery(m_verificationTargets.at(targetId), placeholders));
+
+	auto start = chrono::steady_clock::now();
+	vector<chrono::steady_clock::duration> times;
+	vector<string> unknownReasons;
+	auto results = spacer->queryInParallel(queries, m_settings.threads, &times, &unknownReasons);
+	// The queries share the solver threads, so only the time of the whole batch is known.
+	auto& statistics = m_solverStatistics[solverName()];
+	statistics.time += chrono::steady_clock::now() - start;
+	for (size_t i = 0; i < queries.size(); ++i)
+	{
+		auto& [result, invariant, counterexample] = results[i];
+		++statistics.queries;
+		if (result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE)
+			++statistics.answers;
+		m_parallelResults.push_back({queries[i].name, result, std::move(invariant), std::move(counterexample), times[i], std::move(unknownReasons[i])});
+	}
+#else
+	(void)_targetEntryPoints;
+	solAssert(false);
+#endif
+}
+
+smtutil::Expression CHC::encodeTargetQuery(CHCVerificationTarget const& _target, vector<CHCQueryPlaceholder> const& _placeholders)
+{
+	createErrorBlock();
+	for (auto const& placeholder: _placeholders)
+		connectBlocks(
+			placeholder.fromPredicate,
+			error(),
+			placeholder.constraints && placeholder.errorExpression == _target.errorId
+		);
+	return error();
+}
+
 void CHC::checkAndReportTarget(
 	CHCVerificationTarget const& _target,
 	vector<CHCQueryPlaceholder> const& _placeholders,
@@ -2051,18 +2123,61 @@ void CHC::checkAndReportTarget(
 	string _unknownMsg
 )
 {
+	optional<SolvedQuery> solved;
+	if (!m_parallelResults.empty())
+	{
+		solved = std::move(m_parallelResults.front());
+		m_parallelResults.pop_front();
+	}
+
 	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
 		return;
 
-	createErrorBlock();
-	for (auto const& placeholder: _placeholders)
-		connectBlocks(
-			placeholder.fromPredicate,
-			error(),
-			placeholder.constraints && placeholder.errorExpression == _target.errorId
-		);
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
+	string errorPredicate;
+	CheckResult result;
+	smtutil::Expression invariant(true);
+	CHCSolverInterface::CexGraph model;
+	chrono::steady_clock::duration time{};
+	string unknownReason;
+	if (solved)
+	{
+		errorPredicate = std::move(solved->errorPredicate);
+		result = solved->result;
+		invariant = std::move(solved->invariant);
+		model = std::move(solved->counterexample);
+		time = solved->time;
+		unknownReason = std::move(solved->unknownReason);
+		reportSolverError(result, location);
+	}
+	else
+	{
+		smtutil::Expression targetQuery = encodeTargetQuery(_target, _placeholders);
+		errorPredicate = targetQuery.name;
+		auto start = chrono::steady_clock::now();
+		tie(result, invariant, model) = query(targetQuery, location);
+		time = chrono::steady_clock::now() - start;
+		if (result == CheckResult::UNKNOWN)
+			unknownReason = m_interface->unknownReason();
+	}
+
+	if (m_onTargetChecked)
+	{
+		ModelCheckerTargetStatistics statistics;
+		statistics.engine = "CHC";
+		statistics.type = _target.type;
+		statistics.location = location;
+		statistics.function = _target.function;
+		if (result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE)
+			statistics.solver = solverName();
+		if (auto const* smtlib2 = dynamic_cast<CHCSmtLib2Interface const*>(m_interface.get()); smtlib2 && !solved)
+			statistics.queryBytes = smtlib2->lastQuerySize();
+		statistics.time = time;
+		statistics.result = result;
+		statistics.unknownReason = std::move(unknownReason);
+		m_onTargetChecked(statistics);
+	}
+
 	if (result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target.type);
@@ -2078,7 +2193,7 @@ void CHC::checkAndReportTarget(
 	else if (result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		auto cex = generateCounterexample(model, errorPredicate);
 		if (cex)
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
@@ -2138,14 +2253,14 @@ optional<string> CHC::generateCounterexample(CHCSolverInterface::CexGraph const&
 
 	auto callGraph = summaryCalls(_graph, *rootId);
 
-	auto nodePred = [&](auto _node) { return Predicate::predicate(_graph.nodes.at(_node).name); };
+	auto nodePred = [&](auto _node) { return &m_predicates.at(_graph.nodes.at(_node).name); };
 	auto nodeArgs = [&](auto _node) { return _graph.nodes.at(_node).arguments; };
 
 	bool first = true;
 	for (auto summaryId: callGraph.at(*rootId))
 	{
 		CHCSolverInterface::CexNode const& summaryNode = _graph.nodes.at(summaryId);
-		Predicate const* summaryPredicate = Predicate::predicate(summaryNode.name);
+		Predicate const* summaryPredicate = &m_predicates.at(summaryNode.name);
 		auto const& summaryArgs = summaryNode.arguments;
 
 		if (!summaryPredicate->programVariable())
@@ -2287,8 +2402,8 @@ map<unsigned, vector<unsigned>> CHC::summaryCalls(CHCSolverInterface::CexGraph c
 		auto [node, root] = q.front();
 		q.pop();
 
-		Predicate const* nodePred = Predicate::predicate(_graph.nodes.at(node).name);
-		Predicate const* rootPred = Predicate::predicate(_graph.nodes.at(root).name);
+		Predicate const* nodePred = &m_predicates.at(_graph.nodes.at(node).name);
+		Predicate const* rootPred = &m_predicates.at(_graph.nodes.at(root).name);
 		if (nodePred->isSummary() && (
 			_root == root ||
 			nodePred->isInternalCall() ||
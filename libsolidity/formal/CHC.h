@@ -31,7 +31,9 @@
 
 #pragma once
 
+#include <libsolidity/formal/ArraySlicePredicate.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 #include <libsolidity/formal/Predicate.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
@@ -44,6 +46,7 @@
 
 #include <boost/algorithm/string/join.hpp>
 
+#include <deque>
 #include <map>
 #include <optional>
 #include <set>
@@ -60,7 +63,8 @@ public:
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		ModelCheckerTargetCallback _onTargetChecked = {}
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -79,6 +83,12 @@ public:
 	/// the constructor.
 	std::vector<std::string> unhandledQueries() const;
 
+	/// @returns the counters of the Horn solver, keyed by its name.
+	std::map<std::string, smtutil::SMTPortfolio::SolverStatistics> const& solverStatistics() const
+	{
+		return m_solverStatistics;
+	}
+
 	enum class CHCNatspecOption
 	{
 		AbstractFunctionNondet
@@ -257,6 +267,8 @@ private:
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Reports a warning if the solver could not answer a query.
+	void reportSolverError(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -265,6 +277,13 @@ private:
 	struct CHCVerificationTarget;
 	struct CHCQueryPlaceholder;
 	void checkAssertTarget(ASTNode const* _scope, CHCVerificationTarget const& _target);
+	/// Solves the queries of all targets in @a _targetEntryPoints with m_settings.threads
+	/// Horn solvers, storing the results in m_parallelResults.
+	void solveVerificationTargetsInParallel(std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints);
+	/// Creates a new error block that is reachable if @a _target is reachable from one of
+	/// @a _placeholders, and @returns the query for the error block.
+	smtutil::Expression encodeTargetQuery(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders);
+	/// Checks @a _target, or takes the next result from m_parallelResults if any, and reports it.
 	void checkAndReportTarget(
 		CHCVerificationTarget const& _target,
 		std::vector<CHCQueryPlaceholder> const& _placeholders,
@@ -337,6 +356,11 @@ private:
 
 	/// Predicates.
 	//@{
+	/// All predicates created by the analysis of the current source.
+	Predicate::Registry m_predicates;
+	/// The predicates and rules created to compute array slices, per sort.
+	ArraySlicePredicate::Registry m_arraySlices;
+
 	/// Artificial Interface predicate.
 	/// Single entry block for all functions.
 	std::map<ContractDefinition const*, Predicate const*> m_interfaces;
@@ -374,6 +398,8 @@ private:
 	{
 		unsigned const errorId;
 		ASTNode const* const errorNode;
+		/// The function the target was encountered in, only set if m_onTargetChecked is.
+		std::string const function;
 	};
 
 	/// Query placeholder stores information necessary to create the final query edge in the CHC system.
@@ -406,6 +432,26 @@ private:
 
 	/// Inferred invariants.
 	std::map<Predicate const*, std::set<std::string>, PredicateCompare> m_invariants;
+
+	/// Result of a query solved by solveVerificationTargetsInParallel.
+	struct SolvedQuery
+	{
+		std::string errorPredicate;
+		smtutil::CheckResult result;
+		smtutil::Expression invariant;
+		smtutil::CHCSolverInterface::CexGraph counterexample;
+		std::chrono::steady_clock::duration time{};
+		std::string unknownReason;
+	};
+	/// Results of the queries solved in parallel, in the order in which the targets are checked.
+	std::deque<SolvedQuery> m_parallelResults;
+
+	/// Name of the Horn solver in use, as reported in the statistics.
+	std::string solverName() const;
+	/// Counters of the Horn solver, the query sizes only if it is queried via SMT-LIB2.
+	std::map<std::string, smtutil::SMTPortfolio::SolverStatistics> m_solverStatistics;
+
+	ModelCheckerTargetCallback m_onTargetChecked;
 	//@}
 
 	/// Control-flow.
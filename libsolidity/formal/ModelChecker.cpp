@@ -43,16 +43,30 @@ ModelChecker::ModelChecker(
 	langutil::CharStreamProvider const& _charStreamProvider,
 	map<h256, string> const& _smtlib2Responses,
 	ModelCheckerSettings _settings,
-	ReadCallback::Callback const& _smtCallback
+	ReadCallback::Callback const& _smtCallback,
+	ModelCheckerTargetCallback _progressCallback
 ):
 	m_errorReporter(_errorReporter),
 	m_settings(std::move(_settings)),
+	m_progressCallback(std::move(_progressCallback)),
 	m_context(),
-	m_bmc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider),
-	m_chc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider)
+	m_bmc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider, targetCallback()),
+	m_chc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider, targetCallback())
 {
 }
 
+ModelCheckerTargetCallback ModelChecker::targetCallback()
+{
+	if (!m_settings.statistics && !m_progressCallback)
+		return {};
+	return [this](ModelCheckerTargetStatistics const& _statistics) {
+		if (m_settings.statistics)
+			m_targetStatistics.emplace_back(_statistics);
+		if (m_progressCallback)
+			m_progressCallback(_statistics);
+	};
+}
+
 // TODO This should be removed for 0.9.0.
 bool ModelChecker::isPragmaPresent(vector<shared_ptr<SourceUnit>> const& _sources)
 {
@@ -141,6 +155,16 @@ vector<string> ModelChecker::unhandledQueries()
 	return m_bmc.unhandledQueries() + m_chc.unhandledQueries();
 }
 
+map<string, map<string, SMTPortfolio::SolverStatistics>> ModelChecker::solverStatistics() const
+{
+	map<string, map<string, SMTPortfolio::SolverStatistics>> statistics;
+	if (!m_bmc.solverStatistics().empty())
+		statistics["BMC"] = m_bmc.solverStatistics();
+	if (!m_chc.solverStatistics().empty())
+		statistics["CHC"] = m_chc.solverStatistics();
+	return statistics;
+}
+
 SMTSolverChoice ModelChecker::availableSolvers()
 {
 	smtutil::SMTSolverChoice available = smtutil::SMTSolverChoice::SMTLIB2();
@@ -27,6 +27,7 @@
 #include <libsolidity/formal/CHC.h>
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
@@ -49,12 +50,14 @@ class ModelChecker
 public:
 	/// @param _enabledSolvers represents a runtime choice of which SMT solvers
 	/// should be used, even if all are available. The default choice is to use all.
+	/// @param _progressCallback is called whenever an engine finished checking a target.
 	ModelChecker(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<solidity::util::h256, std::string> const& _smtlib2Responses,
 		ModelCheckerSettings _settings = ModelCheckerSettings{},
-		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback()
+		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback(),
+		ModelCheckerTargetCallback _progressCallback = {}
 	);
 
 	// TODO This should be removed for 0.9.0.
@@ -71,6 +74,17 @@ public:
 	/// the constructor.
 	std::vector<std::string> unhandledQueries();
 
+	/// @returns the counters of the solvers queried by BMC and CHC, keyed by engine ("BMC" or "CHC")
+	/// and solver name. Engines that did not query any solver are omitted.
+	std::map<std::string, std::map<std::string, smtutil::SMTPortfolio::SolverStatistics>> solverStatistics() const;
+
+	/// @returns the sizes of the queries of BMC before and after slicing.
+	smtutil::SlicingStatistics const& slicingStatistics() const { return m_bmc.slicingStatistics(); }
+
+	/// @returns the outcome of every checked target in the order they were checked,
+	/// if ModelCheckerSettings::statistics is set.
+	std::vector<ModelCheckerTargetStatistics> const& targetStatistics() const { return m_targetStatistics; }
+
 	/// @returns SMT solvers that are available via the C++ API.
 	static smtutil::SMTSolverChoice availableSolvers();
 
@@ -79,6 +93,10 @@ public:
 	static smtutil::SMTSolverChoice checkRequestedSolvers(smtutil::SMTSolverChoice _enabled, langutil::ErrorReporter& _errorReporter);
 
 private:
+	/// @returns the callback given to the engines, which is empty if neither
+	/// statistics nor progress are requested.
+	ModelCheckerTargetCallback targetCallback();
+
 	/// Error reporter from CompilerStack.
 	/// We need to append m_uniqueErrorReporter
 	/// to this one when the analysis is done.
@@ -91,6 +109,9 @@ private:
 
 	ModelCheckerSettings m_settings;
 
+	ModelCheckerTargetCallback m_progressCallback;
+	std::vector<ModelCheckerTargetStatistics> m_targetStatistics;
+
 	/// Stores the context of the encoding.
 	smt::EncodingContext m_context;
 
@@ -139,3 +139,15 @@ std::optional<ModelCheckerExtCalls> ModelCheckerExtCalls::fromString(string cons
 		return ModelCheckerExtCalls{Mode::TRUSTED};
 	return {};
 }
+
+std::optional<ModelCheckerPortfolio> ModelCheckerPortfolio::fromString(string const& _mode)
+{
+	using Mode = smtutil::SMTPortfolio::Mode;
+	if (_mode == "sequential")
+		return ModelCheckerPortfolio{Mode::Sequential};
+	if (_mode == "race")
+		return ModelCheckerPortfolio{Mode::Race};
+	if (_mode == "parallel")
+		return ModelCheckerPortfolio{Mode::Parallel};
+	return {};
+}
@@ -18,8 +18,11 @@
 
 #pragma once
 
+#include <libsmtutil/SMTPortfolio.h>
 #include <libsmtutil/SolverInterface.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <optional>
 #include <set>
 
@@ -155,8 +158,20 @@ struct ModelCheckerExtCalls
 	bool isTrusted() const { return mode == Mode::TRUSTED; }
 };
 
+struct ModelCheckerPortfolio
+{
+	smtutil::SMTPortfolio::Mode mode = smtutil::SMTPortfolio::Mode::Sequential;
+
+	/// Parses one of "sequential", "race" and "parallel".
+	static std::optional<ModelCheckerPortfolio> fromString(std::string const& _mode);
+
+	bool isConcurrent() const { return mode != smtutil::SMTPortfolio::Mode::Sequential; }
+};
+
 struct ModelCheckerSettings
 {
+	/// Directory in which the answers of the solvers are cached between runs, if any.
+	std::optional<boost::filesystem::path> cacheDirectory;
 	ModelCheckerContracts contracts = ModelCheckerContracts::Default();
 	/// Currently division and modulo are replaced by multiplication with slack vars, such that
 	/// a / b <=> a = b * k + m
@@ -167,24 +182,45 @@ struct ModelCheckerSettings
 	bool divModNoSlacks = false;
 	ModelCheckerEngine engine = ModelCheckerEngine::None();
 	ModelCheckerExtCalls externalCalls = {};
+	/// Whether BMC asserts the constraints shared by the queries of a contract and of a function
+	/// in the solver once, and checks each query in its own push/pop scope on top of them.
+	bool incremental = false;
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
+	/// How the solvers are queried by BMC if more than one is enabled.
+	ModelCheckerPortfolio portfolio = {};
 	bool showUnproved = false;
+	/// Whether BMC first checks only the part of a query that is in the cone of influence
+	/// of the verification target and its path condition.
+	bool sliceQueries = false;
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::Z3();
+	/// Whether the solver, size, time and result of the query of every target are collected.
+	bool statistics = false;
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
+	/// Number of threads BMC uses to solve the queries of the verification targets
+	/// of a function, and CHC the queries of the verification targets of a source unit.
+	/// The SMT callback is never called concurrently, so queries are
+	/// only solved in parallel by the solvers linked into the compiler.
+	unsigned threads = 1;
 	std::optional<unsigned> timeout;
 
 	bool operator!=(ModelCheckerSettings const& _other) const noexcept { return !(*this == _other); }
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
 	{
 		return
+			cacheDirectory == _other.cacheDirectory &&
 			contracts == _other.contracts &&
 			divModNoSlacks == _other.divModNoSlacks &&
 			engine == _other.engine &&
 			externalCalls.mode == _other.externalCalls.mode &&
+			incremental == _other.incremental &&
 			invariants == _other.invariants &&
+			portfolio.mode == _other.portfolio.mode &&
 			showUnproved == _other.showUnproved &&
+			sliceQueries == _other.sliceQueries &&
 			solvers == _other.solvers &&
+			statistics == _other.statistics &&
 			targets == _other.targets &&
+			threads == _other.threads &&
 			timeout == _other.timeout;
 	}
 };
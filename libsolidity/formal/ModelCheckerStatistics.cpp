@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/ModelCheckerStatistics.h>
+
+#include <libsolidity/ast/AST.h>
+
+#include <liblangutil/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::smtutil;
+
+string ModelCheckerTargetStatistics::resultString() const
+{
+	switch (result)
+	{
+	case CheckResult::SATISFIABLE:
+		return "unsafe";
+	case CheckResult::UNSATISFIABLE:
+		return "safe";
+	case CheckResult::UNKNOWN:
+		return "unknown";
+	case CheckResult::CONFLICTING:
+		return "conflicting";
+	case CheckResult::ERROR:
+		return "error";
+	}
+	solAssert(false);
+}
+
+string ModelCheckerTargetStatistics::typeString() const
+{
+	for (auto const& [name, targetType]: ModelCheckerTargets::targetStrings)
+		if (targetType == type)
+			return name;
+	solAssert(false);
+}
+
+string ModelCheckerTargetStatistics::toString(string const& _position) const
+{
+	string description = engine + ": " + typeString() + " at " + _position;
+	if (!function.empty())
+		description += " in " + function;
+	description += ": " + resultString();
+	description += " (" + (solver.empty() ? "no answer" : solver);
+	if (!unknownReason.empty())
+		description += ": " + unknownReason;
+	description += ", " + to_string(chrono::duration_cast<chrono::milliseconds>(time).count()) + " ms";
+	if (queryBytes > 0)
+		description += ", " + to_string(queryBytes) + " bytes";
+	return description + ")";
+}
+
+string ModelCheckerTargetStatistics::functionName(ContractDefinition const* _contract, CallableDeclaration const* _function)
+{
+	string name = _contract ? _contract->name() + "." : "";
+	if (!_function)
+		return name + "constructor";
+	if (auto const* function = dynamic_cast<FunctionDefinition const*>(_function))
+		if (function->name().empty())
+			return name + TokenTraits::toString(function->kind());
+	return name + _function->name();
+}
@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolidity/formal/ModelCheckerSettings.h>
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+class CallableDeclaration;
+class ContractDefinition;
+
+/// The outcome of checking one verification target.
+struct ModelCheckerTargetStatistics
+{
+	/// "BMC" or "CHC".
+	std::string engine;
+	VerificationTargetType type = VerificationTargetType::Assert;
+	langutil::SourceLocation location;
+	/// The function the target was checked in, as <contract>.<function>.
+	std::string function;
+	/// The solver that answered, or the empty string if no solver gave a SAT or UNSAT answer.
+	std::string solver;
+	/// Size of the query in bytes if it was sent to a solver via SMT-LIB2, and 0 otherwise.
+	size_t queryBytes = 0;
+	/// Time spent solving the queries of the target.
+	std::chrono::steady_clock::duration time{};
+	/// The answer to the query whether the target can be violated.
+	smtutil::CheckResult result = smtutil::CheckResult::ERROR;
+	/// If the result is UNKNOWN, why the solvers gave up, for example "timeout" or "resource limit".
+	/// Empty if the solvers did not say.
+	std::string unknownReason;
+
+	/// @returns "safe", "unsafe", "unknown", "conflicting" or "error".
+	std::string resultString() const;
+	/// @returns the name of the target type as used in ModelCheckerSettings::targets.
+	std::string typeString() const;
+	/// @returns a one line description of the target and its outcome.
+	std::string toString(std::string const& _position) const;
+
+	/// @returns the name of @a _function for the function field, where @a _function
+	/// may be null for implicit constructors.
+	static std::string functionName(ContractDefinition const* _contract, CallableDeclaration const* _function);
+};
+
+/// Called by the engines whenever they finished checking a verification target.
+using ModelCheckerTargetCallback = std::function<void(ModelCheckerTargetStatistics const&)>;
+
+}
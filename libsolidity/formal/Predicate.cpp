@@ -38,13 +38,12 @@ using namespace solidity::smtutil;
 using namespace solidity::frontend;
 using namespace solidity::frontend::smt;
 
-map<string, Predicate> Predicate::m_predicates;
-
 Predicate const* Predicate::create(
 	SortPointer _sort,
 	string _name,
 	PredicateType _type,
 	EncodingContext& _context,
+	Registry& _registry,
 	ASTNode const* _node,
 	ContractDefinition const* _contractContext,
 	vector<ScopeOpener const*> _scopeStack
@@ -52,8 +51,8 @@ Predicate const* Predicate::create(
 {
 	smt::SymbolicFunctionVariable predicate{_sort, std::move(_name), _context};
 	string functorName = predicate.currentName();
-	solAssert(!m_predicates.count(functorName), "");
-	return &m_predicates.emplace(
+	solAssert(!_registry.count(functorName), "");
+	return &_registry.emplace(
 		std::piecewise_construct,
 		std::forward_as_tuple(functorName),
 		std::forward_as_tuple(std::move(predicate), _type, _node, _contractContext, std::move(_scopeStack))
@@ -75,16 +74,6 @@ Predicate::Predicate(
 {
 }
 
-Predicate const* Predicate::predicate(string const& _name)
-{
-	return &m_predicates.at(_name);
-}
-
-void Predicate::reset()
-{
-	m_predicates.clear();
-}
-
 smtutil::Expression Predicate::operator()(vector<smtutil::Expression> const& _args) const
 {
 	return m_predicate(_args);
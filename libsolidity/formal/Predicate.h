@@ -58,11 +58,17 @@ enum class PredicateType
 class Predicate
 {
 public:
+	/// Owns the predicates created by one analysis, indexed by the names of their functors.
+	/// Used in counterexample generation.
+	using Registry = std::map<std::string, Predicate>;
+
+	/// Creates a predicate and stores it in @a _registry.
 	static Predicate const* create(
 		smtutil::SortPointer _sort,
 		std::string _name,
 		PredicateType _type,
 		smt::EncodingContext& _context,
+		Registry& _registry,
 		ASTNode const* _node = nullptr,
 		ContractDefinition const* _contractContext = nullptr,
 		std::vector<ScopeOpener const*> _scopeStack = {}
@@ -80,12 +86,6 @@ public:
 	Predicate(Predicate const&) = delete;
 	Predicate& operator=(Predicate const&) = delete;
 
-	/// @returns the Predicate associated with _name.
-	static Predicate const* predicate(std::string const& _name);
-
-	/// Resets all the allocated predicates.
-	static void reset();
-
 	/// @returns a function application of the predicate over _args.
 	smtutil::Expression operator()(std::vector<smtutil::Expression> const& _args) const;
 
@@ -212,10 +212,6 @@ private:
 	/// function nodes.
 	ContractDefinition const* m_contractContext = nullptr;
 
-	/// Maps the name of the predicate to the actual Predicate.
-	/// Used in counterexample generation.
-	static std::map<std::string, Predicate> m_predicates;
-
 	/// The scope stack when the predicate was created.
 	/// Used to identify the subset of variables in scope.
 	std::vector<ScopeOpener const*> const m_scopeStack;
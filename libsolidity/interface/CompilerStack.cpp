@@ -83,36 +83,132 @@
 
 #include <range/v3/view/concat.hpp>
 
+#include <condition_variable>
 #include <utility>
 #include <map>
 #include <limits>
+#include <mutex>
 #include <string>
+#include <thread>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// Parses sources on a number of threads, each source with its own parser and error reporter.
+/// Sources are parsed in the order in which they are added.
+class ParallelParser
+{
+public:
+	struct ParsedSource
+	{
+		ParsedSource(shared_ptr<CharStream> _charStream, EVMVersion _evmVersion, bool _errorRecovery):
+			charStream(std::move(_charStream)),
+			parser(errorReporter, _evmVersion, _errorRecovery)
+		{
+			parser.recordCreatedNodes();
+		}
+
+		shared_ptr<CharStream> charStream;
+		ErrorList errors;
+		ErrorReporter errorReporter{errors};
+		Parser parser;
+		ASTPointer<SourceUnit> ast;
+		exception_ptr exception;
+		bool parsed = false;
+	};
+
+	ParallelParser(unsigned _threads, EVMVersion _evmVersion, bool _errorRecovery):
+		m_evmVersion(_evmVersion),
+		m_errorRecovery(_errorRecovery)
+	{
+		for (unsigned i = 0; i < _threads; ++i)
+			m_threads.emplace_back([this]() { work(); });
+	}
+
+	~ParallelParser()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_sourceAdded.notify_all();
+		for (auto& thread: m_threads)
+			thread.join();
+	}
+
+	void add(shared_ptr<CharStream> _charStream)
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_sources.emplace_back(make_unique<ParsedSource>(std::move(_charStream), m_evmVersion, m_errorRecovery));
+		}
+		m_sourceAdded.notify_one();
+	}
+
+	/// Waits until the source added as the @a _index-th one is parsed and @returns it.
+	ParsedSource& get(size_t _index)
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_sourceParsed.wait(lock, [&]() { return m_sources.at(_index)->parsed; });
+		ParsedSource& source = *m_sources[_index];
+		if (source.exception)
+			rethrow_exception(source.exception);
+		return source;
+	}
+
+private:
+	void work()
+	{
+		unique_lock<mutex> lock(m_mutex);
+		while (true)
+		{
+			m_sourceAdded.wait(lock, [&]() { return m_stop || m_nextSource < m_sources.size(); });
+			if (m_stop)
+				return;
+			ParsedSource& source = *m_sources[m_nextSource++];
+			lock.unlock();
+			try
+			{
+				source.ast = source.parser.parse(*source.charStream);
+			}
+			catch (...)
+			{
+				source.exception = current_exception();
+			}
+			lock.lock();
+			source.parsed = true;
+			m_sourceParsed.notify_all();
+		}
+	}
+
+	EVMVersion const m_evmVersion;
+	bool const m_errorRecovery;
+	mutex m_mutex;
+	condition_variable m_sourceAdded;
+	condition_variable m_sourceParsed;
+	vector<unique_ptr<ParsedSource>> m_sources;
+	size_t m_nextSource = 0;
+	bool m_stop = false;
+	vector<thread> m_threads;
+};
+
+}
+
 using solidity::util::errinfo_comment;
 using solidity::util::toHex;
 
-static int g_compilerStackCounts = 0;
-
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
 }
 
-CompilerStack::~CompilerStack()
-{
-	--g_compilerStackCounts;
-	TypeProvider::reset();
-}
+CompilerStack::~CompilerStack() = default;
 
 void CompilerStack::createAndAssignCallGraphs()
 {
@@ -241,6 +337,11 @@ void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
 	m_modelCheckerSettings = _settings;
 }
 
+void CompilerStack::setModelCheckerProgressCallback(ModelCheckerTargetCallback _callback)
+{
+	m_modelCheckerProgressCallback = std::move(_callback);
+}
+
 void CompilerStack::setLibraries(std::map<std::string, util::h160> const& _libraries)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -300,11 +401,16 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _respons
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	// The types refer to the AST, so they are destroyed first.
+	m_typeProvider.reset();
 	m_stackState = Empty;
 	m_hasError = false;
 	m_sources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
+	m_modelCheckerSolverStatistics.clear();
+	m_modelCheckerSlicingStatistics = {};
+	m_modelCheckerTargetStatistics.clear();
 	if (!_keepSettings)
 	{
 		m_importRemapper.clear();
@@ -320,12 +426,12 @@ void CompilerStack::reset(bool _keepSettings)
 		m_metadataFormat = defaultMetadataFormat();
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
+		m_parserThreads = 1;
 	}
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
-	TypeProvider::reset();
 }
 
 void CompilerStack::setSources(StringMap _sources)
@@ -334,13 +440,28 @@ void CompilerStack::setSources(StringMap _sources)
 		solThrow(CompilerError, "Cannot change sources once set.");
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must set sources before parsing.");
-	for (auto source: _sources)
-		m_sources[source.first].charStream = make_unique<CharStream>(/*content*/std::move(source.second), /*name*/source.first);
+	for (auto& [name, content]: _sources)
+		m_sources[name].charStream = make_unique<CharStream>(std::move(content), name);
+	m_stackState = SourcesSet;
+}
+
+void CompilerStack::setSources(map<string, CharStream> _sources)
+{
+	if (m_stackState == SourcesSet)
+		solThrow(CompilerError, "Cannot change sources once set.");
+	if (m_stackState != Empty)
+		solThrow(CompilerError, "Must set sources before parsing.");
+	for (auto& [name, charStream]: _sources)
+	{
+		solAssert(charStream.name() == name, "");
+		m_sources[name].charStream = make_shared<CharStream>(std::move(charStream));
+	}
 	m_stackState = SourcesSet;
 }
 
 bool CompilerStack::parse()
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState != SourcesSet)
 		solThrow(CompilerError, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
@@ -348,17 +469,37 @@ bool CompilerStack::parse()
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
-
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 
+	// With more than one thread, the sources are parsed ahead by the parallel parser, while the
+	// results are still taken in the order of sourcesToParse, which also determines the node IDs.
+	// The read callback is only called from this thread.
+	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+	unique_ptr<ParallelParser> parallelParser;
+	if (m_parserThreads > 1)
+	{
+		parallelParser = make_unique<ParallelParser>(m_parserThreads, m_evmVersion, m_parserErrorRecovery);
+		for (string const& path: sourcesToParse)
+			parallelParser->add(m_sources[path].charStream);
+	}
+	int64_t lastNodeID = 0;
+
 	for (size_t i = 0; i < sourcesToParse.size(); ++i)
 	{
-		string const& path = sourcesToParse[i];
+		string const path = sourcesToParse[i];
 		Source& source = m_sources[path];
-		source.ast = parser.parse(*source.charStream);
+		if (parallelParser)
+		{
+			ParallelParser::ParsedSource& parsedSource = parallelParser->get(i);
+			parsedSource.parser.shiftNodeIDs(lastNodeID);
+			lastNodeID = parsedSource.parser.lastNodeID();
+			m_errorReporter.append(parsedSource.errors);
+			source.ast = parsedSource.ast;
+		}
+		else
+			source.ast = parser.parse(*source.charStream);
 		if (!source.ast)
 			solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
@@ -379,12 +520,12 @@ bool CompilerStack::parse()
 			}
 
 			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast))
+				for (auto& [newPath, newCharStream]: loadMissingSources(*source.ast))
 				{
-					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].charStream = make_shared<CharStream>(newContents, newPath);
+					m_sources[newPath].charStream = std::move(newCharStream);
 					sourcesToParse.push_back(newPath);
+					if (parallelParser)
+						parallelParser->add(m_sources[newPath].charStream);
 				}
 		}
 	}
@@ -403,6 +544,7 @@ bool CompilerStack::parse()
 
 void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must call importASTs only before the SourcesSet state.");
 	m_sourceJsons = _sources;
@@ -427,6 +569,7 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 
 bool CompilerStack::analyze()
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		solThrow(CompilerError, "Must call analyze only after parsing was performed.");
 	resolveImports();
@@ -597,12 +740,22 @@ bool CompilerStack::analyze()
 			if (m_modelCheckerSettings.engine.any())
 				m_modelCheckerSettings.solvers = ModelChecker::checkRequestedSolvers(m_modelCheckerSettings.solvers, m_errorReporter);
 
-			ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile);
+			ModelChecker modelChecker(
+				m_errorReporter,
+				*this,
+				m_smtlib2Responses,
+				m_modelCheckerSettings,
+				m_readFile,
+				m_modelCheckerProgressCallback
+			);
 			modelChecker.checkRequestedSourcesAndContracts(allSources);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
 					modelChecker.analyze(*source->ast);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
+			m_modelCheckerSolverStatistics = modelChecker.solverStatistics();
+			m_modelCheckerSlicingStatistics = modelChecker.slicingStatistics();
+			m_modelCheckerTargetStatistics = modelChecker.targetStatistics();
 		}
 	}
 	catch (FatalError const&)
@@ -658,6 +811,7 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 
 bool CompilerStack::compile(State _stopAfter)
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	m_stopAfter = _stopAfter;
 	if (m_stackState < AnalysisPerformed)
 		if (!parseAndAnalyze(_stopAfter))
@@ -977,6 +1131,7 @@ Json::Value const& CompilerStack::contractABI(string const& _contractName) const
 
 Json::Value const& CompilerStack::contractABI(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -995,6 +1150,7 @@ Json::Value const& CompilerStack::storageLayout(string const& _contractName) con
 
 Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1013,6 +1169,7 @@ Json::Value const& CompilerStack::natspecUser(string const& _contractName) const
 
 Json::Value const& CompilerStack::natspecUser(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1031,6 +1188,7 @@ Json::Value const& CompilerStack::natspecDev(string const& _contractName) const
 
 Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1041,6 +1199,7 @@ Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 
 Json::Value CompilerStack::interfaceSymbols(string const& _contractName) const
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1071,6 +1230,7 @@ Json::Value CompilerStack::interfaceSymbols(string const& _contractName) const
 
 bytes CompilerStack::cborMetadata(string const& _contractName, bool _forIR) const
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1079,6 +1239,7 @@ bytes CompilerStack::cborMetadata(string const& _contractName, bool _forIR) cons
 
 string const& CompilerStack::metadata(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1133,28 +1294,34 @@ size_t CompilerStack::functionEntryPoint(
 h256 const& CompilerStack::Source::keccak256() const
 {
 	if (keccak256HashCached == h256{})
-		keccak256HashCached = util::keccak256(charStream->source());
+	{
+		string_view source = charStream->source();
+		keccak256HashCached = util::keccak256(bytesConstRef(reinterpret_cast<uint8_t const*>(source.data()), source.size()));
+	}
 	return keccak256HashCached;
 }
 
 h256 const& CompilerStack::Source::swarmHash() const
 {
 	if (swarmHashCached == h256{})
-		swarmHashCached = util::bzzr1Hash(charStream->source());
+	{
+		string_view source = charStream->source();
+		swarmHashCached = util::bzzr1Hash(bytes(source.begin(), source.end()));
+	}
 	return swarmHashCached;
 }
 
 string const& CompilerStack::Source::ipfsUrl() const
 {
 	if (ipfsUrlCached.empty())
-		ipfsUrlCached = "dweb:/ipfs/" + util::ipfsHashBase58(charStream->source());
+		ipfsUrlCached = "dweb:/ipfs/" + util::ipfsHashBase58(string(charStream->source()));
 	return ipfsUrlCached;
 }
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
+map<string, shared_ptr<CharStream>> CompilerStack::loadMissingSources(SourceUnit const& _ast)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
-	StringMap newSources;
+	map<string, shared_ptr<CharStream>> newSources;
 	try
 	{
 		for (auto const& node: _ast.nodes())
@@ -1169,8 +1336,10 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 				if (m_readFile)
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
 
-				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+				if (result.success && result.file)
+					newSources[importPath] = make_shared<CharStream>(std::move(result.file), importPath);
+				else if (result.success)
+					newSources[importPath] = make_shared<CharStream>(std::move(result.responseOrErrorMessage), importPath);
 				else
 				{
 					m_errorReporter.parserError(
@@ -1542,7 +1711,7 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 		if (optional<string> licenseString = s.second.ast->licenseString())
 			meta["sources"][s.first]["license"] = *licenseString;
 		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.charStream->source();
+			meta["sources"][s.first]["content"] = string(s.second.charStream->source());
 		else
 		{
 			meta["sources"][s.first]["urls"] = Json::arrayValue;
@@ -1756,6 +1925,7 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 {
+	TypeProvider::Scope typeProviderScope{m_typeProvider};
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -32,7 +33,10 @@
 #include <libsolidity/interface/DebugSettings.h>
 
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 
+#include <libsmtutil/ConeOfInfluence.h>
+#include <libsmtutil/SMTPortfolio.h>
 #include <libsmtutil/SolverInterface.h>
 
 #include <liblangutil/CharStreamProvider.h>
@@ -88,6 +92,10 @@ class DeclarationContainer;
  * before compilation to bytecode) or run the whole compilation in one call.
  * If error recovery is active, it is possible to progress through the stages even when
  * there are errors. In any case, producing code is only possible without errors.
+ * The types of a compilation are owned by its CompilerStack, which makes them current while one
+ * of its member functions runs. Several instances can therefore be used alternately on the same
+ * thread. They must not be used concurrently, since other parts of the compiler, for example
+ * YulStringRepository and the EVM dialects, are still shared by the whole process.
  */
 class CompilerStack: public langutil::CharStreamProvider
 {
@@ -172,6 +180,15 @@ public:
 		m_parserErrorRecovery = _wantErrorRecovery;
 	}
 
+	/// Set the number of threads used to parse the sources. With more than one, the sources
+	/// are parsed concurrently while the imports of the already parsed ones are loaded.
+	/// Must be set before parsing.
+	void setParserThreads(unsigned _threads)
+	{
+		solAssert(_threads > 0, "");
+		m_parserThreads = _threads;
+	}
+
 	/// Sets the pipeline to go through the Yul IR or not.
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
@@ -188,6 +205,9 @@ public:
 	/// Set model checker settings.
 	void setModelCheckerSettings(ModelCheckerSettings _settings);
 
+	/// Sets a callback that is called whenever the model checker finished checking a target.
+	void setModelCheckerProgressCallback(ModelCheckerTargetCallback _callback);
+
 	/// Sets the requested contract names by source.
 	/// If empty, no filtering is performed and every contract
 	/// found in the supplied sources is compiled.
@@ -220,6 +240,9 @@ public:
 
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
+	/// Sets the sources as streams, whose contents are shared instead of copied.
+	/// Must be set before parsing.
+	void setSources(std::map<std::string, langutil::CharStream> _sources);
 
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
@@ -263,10 +286,32 @@ public:
 	/// does not exist.
 	ContractDefinition const& contractDefinition(std::string const& _contractName) const;
 
+	/// @returns a scope that makes the types of this compilation current on the calling thread.
+	/// Code that uses the types of the AST outside of the member functions of this class,
+	/// for example to export it, has to keep the scope alive meanwhile.
+	TypeProvider::Scope typeProviderScope() const { return TypeProvider::Scope(m_typeProvider); }
+
 	/// @returns a list of unhandled queries to the SMT solver (has to be supplied in a second run
 	/// by calling @a addSMTLib2Response).
 	std::vector<std::string> const& unhandledSMTLib2Queries() const { return m_unhandledSMTLib2Queries; }
 
+	/// @returns the counters of the SMT solvers queried by the model checker,
+	/// keyed by engine ("BMC" or "CHC") and solver name.
+	std::map<std::string, std::map<std::string, smtutil::SMTPortfolio::SolverStatistics>> const& modelCheckerSolverStatistics() const
+	{
+		return m_modelCheckerSolverStatistics;
+	}
+
+	/// @returns the sizes of the queries of the model checker before and after slicing.
+	smtutil::SlicingStatistics const& modelCheckerSlicingStatistics() const { return m_modelCheckerSlicingStatistics; }
+
+	/// @returns the outcome of every target checked by the model checker,
+	/// if the model checker setting statistics is set.
+	std::vector<ModelCheckerTargetStatistics> const& modelCheckerTargetStatistics() const
+	{
+		return m_modelCheckerTargetStatistics;
+	}
+
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
 
@@ -408,7 +453,7 @@ private:
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile
 	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast);
+	std::map<std::string, std::shared_ptr<langutil::CharStream>> loadMissingSources(SourceUnit const& _ast);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
@@ -496,6 +541,9 @@ private:
 		FunctionDefinition const& _function
 	) const;
 
+	/// The types of this compilation, made current by the member functions that may create types.
+	mutable TypeProvider m_typeProvider;
+
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
@@ -504,6 +552,7 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
+	ModelCheckerTargetCallback m_modelCheckerProgressCallback;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
@@ -514,6 +563,9 @@ private:
 	// if imported, store AST-JSONS for each filename
 	std::map<std::string, Json::Value> m_sourceJsons;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
+	std::map<std::string, std::map<std::string, smtutil::SMTPortfolio::SolverStatistics>> m_modelCheckerSolverStatistics;
+	smtutil::SlicingStatistics m_modelCheckerSlicingStatistics;
+	std::vector<ModelCheckerTargetStatistics> m_modelCheckerTargetStatistics;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
@@ -525,6 +577,7 @@ private:
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	langutil::DebugInfoSelection m_debugInfoSelection = langutil::DebugInfoSelection::Default();
 	bool m_parserErrorRecovery = false;
+	unsigned m_parserThreads = 1;
 	State m_stackState = Empty;
 	CompilationSourceType m_compilationSourceType = CompilationSourceType::Solidity;
 	/// Whether or not there has been an error during processing.
@@ -21,6 +21,7 @@
 
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
+#include <libsolutil/MappedFile.h>
 #include <libsolutil/StringUtils.h>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -31,10 +32,11 @@
 #include <functional>
 
 using solidity::frontend::ReadCallback;
+using solidity::langutil::CharStream;
 using solidity::langutil::InternalCompilerError;
 using solidity::util::errinfo_comment;
-using solidity::util::readFileAsString;
 using solidity::util::joinHumanReadable;
+using std::make_shared;
 using std::map;
 using std::reference_wrapper;
 using std::string;
@@ -84,19 +86,43 @@ void FileReader::allowDirectory(boost::filesystem::path _path)
 	m_allowedDirectories.insert(std::move(_path));
 }
 
+FileReader::StringMap const& FileReader::sourceUnits() const
+{
+	if (!m_sourceCodes)
+	{
+		m_sourceCodes.emplace();
+		for (auto const& [name, charStream]: m_sources)
+			m_sourceCodes->emplace(name, charStream.source());
+	}
+	return *m_sourceCodes;
+}
+
 void FileReader::addOrUpdateFile(boost::filesystem::path const& _path, SourceCode _source)
 {
-	m_sourceCodes[cliPathToSourceUnitName(_path)] = std::move(_source);
+	string sourceUnitName = cliPathToSourceUnitName(_path);
+	m_sources.insert_or_assign(sourceUnitName, CharStream(std::move(_source), sourceUnitName));
+	m_sourceCodes.reset();
+}
+
+void FileReader::mapFile(boost::filesystem::path const& _path)
+{
+	string sourceUnitName = cliPathToSourceUnitName(_path);
+	m_sources.insert_or_assign(sourceUnitName, CharStream(make_shared<util::MappedFile const>(_path), sourceUnitName));
+	m_sourceCodes.reset();
 }
 
 void FileReader::setStdin(SourceCode _source)
 {
-	m_sourceCodes["<stdin>"] = std::move(_source);
+	m_sources.insert_or_assign("<stdin>", CharStream(std::move(_source), "<stdin>"));
+	m_sourceCodes.reset();
 }
 
 void FileReader::setSourceUnits(StringMap _sources)
 {
-	m_sourceCodes = std::move(_sources);
+	m_sources.clear();
+	for (auto& [name, source]: _sources)
+		m_sources.emplace(name, CharStream(std::move(source), name));
+	m_sourceCodes.reset();
 }
 
 ReadCallback::Result FileReader::readFile(string const& _kind, string const& _sourceUnitName)
@@ -164,10 +190,11 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 			return ReadCallback::Result{false, "Not a valid file."};
 
 		// NOTE: we ignore the FileNotFound exception as we manually check above
-		auto contents = readFileAsString(candidates[0]);
-		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
-		m_sourceCodes[_sourceUnitName] = contents;
-		return ReadCallback::Result{true, contents};
+		auto file = make_shared<util::MappedFile const>(candidates[0]);
+		solAssert(m_sources.count(_sourceUnitName) == 0, "");
+		m_sources.emplace(_sourceUnitName, CharStream(file, _sourceUnitName));
+		m_sourceCodes.reset();
+		return ReadCallback::Result{true, {}, std::move(file)};
 	}
 	catch (util::Exception const& _exception)
 	{
@@ -20,9 +20,12 @@
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/ReadFile.h>
 
+#include <liblangutil/CharStream.h>
+
 #include <boost/filesystem.hpp>
 
 #include <map>
+#include <optional>
 #include <set>
 
 namespace solidity::frontend
@@ -36,6 +39,7 @@ class FileReader
 {
 public:
 	using StringMap = std::map<SourceUnitName, SourceCode>;
+	using CharStreamMap = std::map<SourceUnitName, langutil::CharStream>;
 	using PathMap = std::map<SourceUnitName, boost::filesystem::path>;
 	using FileSystemPathSet = std::set<boost::filesystem::path>;
 
@@ -61,8 +65,12 @@ public:
 	void allowDirectory(boost::filesystem::path _path);
 	FileSystemPathSet const& allowedDirectories() const noexcept { return m_allowedDirectories; }
 
-	/// @returns all sources by their internal source unit names.
-	StringMap const& sourceUnits() const noexcept { return m_sourceCodes; }
+	/// @returns all sources by their internal source unit names. The contents of mapped files
+	/// are copied the first time they are requested after a change.
+	StringMap const& sourceUnits() const;
+	/// @returns all sources by their internal source unit names, as streams that share the
+	/// contents with the reader instead of copying them.
+	CharStreamMap const& sourceStreams() const noexcept { return m_sources; }
 
 	/// Resets all sources to the given map of source unit name to source codes.
 	/// Does not enforce @a allowedDirectories().
@@ -72,6 +80,9 @@ public:
 	/// or changes an existing source.
 	/// Does not enforce @a allowedDirectories().
 	void addOrUpdateFile(boost::filesystem::path const& _path, SourceCode _source);
+	/// Maps the file at @a _path into memory and adds it like addOrUpdateFile.
+	/// Does not enforce @a allowedDirectories().
+	void mapFile(boost::filesystem::path const& _path);
 
 	/// Adds the source code under the source unit name of @a <stdin>.
 	/// Does not enforce @a allowedDirectories().
@@ -81,9 +92,8 @@ public:
 	/// and attempts to interpret it as a path and read the corresponding file from disk.
 	/// The read will only succeed if the canonical path of the file is within one of the @a allowedDirectories().
 	/// @param _kind must be equal to "source". Other values are not supported.
-	/// @return Content of the loaded file or an error message. If the operation succeeds, a copy of
-	/// the content is retained in @a sourceUnits() under the key of @a _sourceUnitName. If the key
-	/// already exists, previous content is discarded.
+	/// @return The loaded file, which is mapped into memory, or an error message. If the operation
+	/// succeeds, the file is retained in @a sourceUnits() under the key of @a _sourceUnitName.
 	frontend::ReadCallback::Result readFile(std::string const& _kind, std::string const& _sourceUnitName);
 
 	frontend::ReadCallback::Callback reader()
@@ -164,8 +174,10 @@ private:
 	/// list of allowed directories to read files from
 	FileSystemPathSet m_allowedDirectories;
 
-	/// map of input files to source code strings
-	StringMap m_sourceCodes;
+	/// map of input files to their contents, which are strings or mapped files
+	CharStreamMap m_sources;
+	/// copies of the contents of m_sources, made by sourceUnits() when they are requested
+	mutable std::optional<StringMap> m_sourceCodes;
 };
 
 }
@@ -21,8 +21,14 @@
 #include <liblangutil/Exceptions.h>
 
 #include <functional>
+#include <memory>
 #include <string>
 
+namespace solidity::util
+{
+class MappedFile;
+}
+
 namespace solidity::frontend
 {
 
@@ -38,12 +44,16 @@ public:
 	{
 		bool success;
 		std::string responseOrErrorMessage;
+		/// If set, the file that was read, whose contents are then not copied into responseOrErrorMessage.
+		std::shared_ptr<util::MappedFile const> file = {};
 	};
 
 	enum class Kind
 	{
 		ReadFile,
-		SMTQuery
+		SMTQuery,
+		/// Asks for the version of the solver that answers SMTQuery, to key its answers in the query cache.
+		SMTSolverVersion
 	};
 
 	static std::string kindString(Kind _kind)
@@ -54,6 +64,8 @@ public:
 			return "source";
 		case Kind::SMTQuery:
 			return "smt-query";
+		case Kind::SMTSolverVersion:
+			return "smt-solver-version";
 		default:
 			solAssert(false, "");
 		}
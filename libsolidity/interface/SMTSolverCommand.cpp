@@ -26,9 +26,13 @@
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/process.hpp>
+#include <boost/process/async_pipe.hpp>
 
 using solidity::langutil::InternalCompilerError;
 using solidity::util::errinfo_comment;
@@ -38,48 +42,268 @@ using namespace std;
 namespace solidity::frontend
 {
 
+namespace
+{
+
+/// Printed by the solver via `(echo)` after its answer to a query.
+string const answerEndMarker = "solc-smt-answer-end";
+
+/// Removes empty lines, like the answers of solvers started for a single query.
+string nonEmptyLines(string const& _output)
+{
+	vector<string> lines;
+	boost::split(lines, _output, boost::is_any_of("\n"));
+	vector<string> data;
+	for (string& line: lines)
+		if (!line.empty())
+			data.push_back(std::move(line));
+	return boost::join(data, "\n");
+}
+
+}
+
+/// A solver process in interactive mode that answers queries sent to its standard input.
+class SMTSolverCommand::Process
+{
+public:
+	Process(boost::filesystem::path const& _binary, vector<string> const& _arguments):
+		m_input(m_io),
+		m_output(m_io),
+		m_child(
+			_binary,
+			boost::process::args(_arguments),
+			boost::process::std_in < m_input,
+			boost::process::std_out > m_output
+		)
+	{}
+
+	~Process()
+	{
+		terminate();
+	}
+
+	bool running()
+	{
+		error_code error;
+		return m_child.running(error);
+	}
+
+	/// @returns the answer of the solver to @a _query, `unknown` if the solver did not answer
+	/// within @a _timeout or nullopt if the process exited.
+	/// The process is terminated if it does not answer.
+	optional<string> query(string const& _query, optional<chrono::milliseconds> _timeout)
+	{
+		// Writing to a process that has already exited would fail, or raise SIGPIPE.
+		if (!running())
+			return nullopt;
+
+		string request = _query + "\n(echo \"" + answerEndMarker + "\")\n(reset)\n";
+		bool writing = true;
+		bool reading = true;
+		bool failed = false;
+		optional<size_t> answerSize;
+		boost::asio::async_write(m_input, boost::asio::buffer(request), [&](boost::system::error_code const& _error, size_t) {
+			writing = false;
+			if (_error)
+				failed = true;
+		});
+		boost::asio::async_read_until(m_output, m_buffer, answerEndMarker, [&](boost::system::error_code const& _error, size_t _size) {
+			reading = false;
+			if (_error)
+				failed = true;
+			else
+				answerSize = _size;
+		});
+
+		// Both handlers have to run before returning, since they refer to the local variables.
+		m_io.restart();
+		auto deadline = chrono::steady_clock::now() + _timeout.value_or(chrono::milliseconds::zero());
+		while (writing || reading)
+			if ((_timeout ? m_io.run_one_until(deadline) : m_io.run_one()) == 0)
+				break;
+
+		if (!answerSize)
+		{
+			bool timedOut = !failed;
+			terminate();
+			if (timedOut)
+				return "unknown";
+			return nullopt;
+		}
+
+		auto begin = boost::asio::buffers_begin(m_buffer.data());
+		string answer(begin, begin + static_cast<ptrdiff_t>(*answerSize - answerEndMarker.size()));
+		m_buffer.consume(*answerSize);
+		return nonEmptyLines(answer);
+	}
+
+private:
+	void terminate()
+	{
+		error_code error;
+		if (m_child.running(error))
+			m_child.terminate(error);
+		m_child.wait(error);
+		// The reads and writes that are still pending are never completed.
+		m_io.stop();
+	}
+
+	boost::asio::io_context m_io;
+	boost::process::async_pipe m_input;
+	boost::process::async_pipe m_output;
+	boost::asio::streambuf m_buffer;
+	boost::process::child m_child;
+};
+
 SMTSolverCommand::SMTSolverCommand(string _solverCmd) : m_solverCmd(_solverCmd) {}
 
+SMTSolverCommand::~SMTSolverCommand() = default;
+
+void SMTSolverCommand::setProcessPool(
+	size_t _processes,
+	optional<chrono::milliseconds> _queryTimeout,
+	vector<string> _interactiveArguments
+)
+{
+	lock_guard<mutex> lock(m_poolMutex);
+	solAssert(m_liveProcesses == m_idleProcesses.size(), "Process pool changed while solving a query.");
+	m_maxProcesses = _processes;
+	m_queryTimeout = _queryTimeout;
+	m_interactiveArguments = std::move(_interactiveArguments);
+	m_idleProcesses.clear();
+	m_liveProcesses = 0;
+}
+
 ReadCallback::Result SMTSolverCommand::solve(string const& _kind, string const& _query)
 {
 	try
 	{
-		if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
+		bool const versionQuery = _kind == ReadCallback::kindString(ReadCallback::Kind::SMTSolverVersion);
+		if (!versionQuery && _kind != ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
 			solAssert(false, "SMTQuery callback used as callback kind " + _kind);
 
-		auto tempDir = solidity::util::TemporaryDirectory("smt");
-		util::h256 queryHash = util::keccak256(_query);
-		auto queryFileName = tempDir.path() / ("query_" + queryHash.hex() + ".smt2");
-
-		auto queryFile = boost::filesystem::ofstream(queryFileName);
-		queryFile << _query;
-
-		auto eldBin = boost::process::search_path(m_solverCmd);
+		auto eldBin = solverBinary();
 
 		if (eldBin.empty())
 			return ReadCallback::Result{false, m_solverCmd + " binary not found."};
 
-		boost::process::ipstream pipe;
-		boost::process::child eld(
-			eldBin,
-			queryFileName,
-			boost::process::std_out > pipe
-		);
+		if (versionQuery)
+			return solverVersion(eldBin);
 
-		vector<string> data;
-		string line;
-		while (eld.running() && std::getline(pipe, line))
-			if (!line.empty())
-				data.push_back(line);
+		if (m_maxProcesses > 0)
+			return solveWithProcessPool(eldBin, _query);
+		return solveWithNewProcess(eldBin, _query);
+	}
+	catch (...)
+	{
+		return ReadCallback::Result{false, "Unknown exception in SMTQuery callback: " + boost::current_exception_diagnostic_information()};
+	}
+}
+
+boost::filesystem::path SMTSolverCommand::solverBinary() const
+{
+	boost::filesystem::path solverCmd(m_solverCmd);
+	if (solverCmd.has_parent_path())
+		return boost::filesystem::exists(solverCmd) ? solverCmd : boost::filesystem::path{};
+	return boost::process::search_path(m_solverCmd);
+}
+
+ReadCallback::Result SMTSolverCommand::solverVersion(boost::filesystem::path const& _binary)
+{
+	// Solvers do not agree on an option that prints their version, and running a JVM
+	// based solver only for that is slow, so the binary itself identifies the version.
+	boost::filesystem::path binary = boost::filesystem::canonical(_binary);
+	return ReadCallback::Result{
+		true,
+		binary.string() + " " +
+		to_string(boost::filesystem::file_size(binary)) + " " +
+		to_string(boost::filesystem::last_write_time(binary))
+	};
+}
+
+ReadCallback::Result SMTSolverCommand::solveWithNewProcess(boost::filesystem::path const& _binary, string const& _query)
+{
+	auto tempDir = solidity::util::TemporaryDirectory("smt");
+	util::h256 queryHash = util::keccak256(_query);
+	auto queryFileName = tempDir.path() / ("query_" + queryHash.hex() + ".smt2");
+
+	auto queryFile = boost::filesystem::ofstream(queryFileName);
+	queryFile << _query;
+	queryFile.close();
+
+	boost::process::ipstream pipe;
+	boost::process::child eld(
+		_binary,
+		queryFileName,
+		boost::process::std_out > pipe
+	);
+
+	vector<string> data;
+	string line;
+	while (eld.running() && std::getline(pipe, line))
+		if (!line.empty())
+			data.push_back(line);
+
+	eld.wait();
+
+	return ReadCallback::Result{true, boost::join(data, "\n")};
+}
 
-		eld.wait();
+ReadCallback::Result SMTSolverCommand::solveWithProcessPool(boost::filesystem::path const& _binary, string const& _query)
+{
+	// A process may have exited since its last query, so the query is sent to a new process once.
+	for (size_t attempt = 0; attempt < 2; ++attempt)
+	{
+		unique_ptr<Process> process = acquireProcess(_binary);
+		optional<string> answer = process->query(_query, m_queryTimeout);
+		releaseProcess(std::move(process));
+		if (answer)
+			return ReadCallback::Result{true, std::move(*answer)};
+	}
+	return ReadCallback::Result{false, m_solverCmd + " exited before answering the query."};
+}
 
-		return ReadCallback::Result{true, boost::join(data, "\n")};
+unique_ptr<SMTSolverCommand::Process> SMTSolverCommand::acquireProcess(boost::filesystem::path const& _binary)
+{
+	{
+		unique_lock<mutex> lock(m_poolMutex);
+		m_processReleased.wait(lock, [&] {
+			return !m_idleProcesses.empty() || m_liveProcesses < m_maxProcesses;
+		});
+		if (!m_idleProcesses.empty())
+		{
+			unique_ptr<Process> process = std::move(m_idleProcesses.back());
+			m_idleProcesses.pop_back();
+			return process;
+		}
+		++m_liveProcesses;
+	}
+
+	try
+	{
+		return make_unique<Process>(_binary, m_interactiveArguments);
 	}
 	catch (...)
 	{
-		return ReadCallback::Result{false, "Unknown exception in SMTQuery callback: " + boost::current_exception_diagnostic_information()};
+		{
+			lock_guard<mutex> lock(m_poolMutex);
+			--m_liveProcesses;
+		}
+		m_processReleased.notify_one();
+		throw;
+	}
+}
+
+void SMTSolverCommand::releaseProcess(unique_ptr<Process> _process)
+{
+	{
+		lock_guard<mutex> lock(m_poolMutex);
+		if (_process->running())
+			m_idleProcesses.push_back(std::move(_process));
+		else
+			--m_liveProcesses;
 	}
+	m_processReleased.notify_one();
 }
 
 }
@@ -21,16 +21,42 @@
 
 #include <boost/filesystem.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
 namespace solidity::frontend
 {
 
 /// SMTSolverCommand wraps an SMT solver called via its binary in the OS.
+///
+/// By default a new solver process is started for every query. Optionally, a pool of
+/// long-lived solver processes in interactive mode can answer the queries instead, which
+/// avoids the startup time of the solver for every query.
 class SMTSolverCommand
 {
 public:
 	SMTSolverCommand(std::string _solverCmd);
+	~SMTSolverCommand();
+
+	/// Makes up to @a _processes long-lived solver processes answer the queries. The processes
+	/// are started with @a _interactiveArguments, read the queries from their standard input and
+	/// have to support the SMT-LIB commands `(echo)` and `(reset)`, like `z3 -in` does.
+	/// More than one process is only started if solve is called from several threads at the same time.
+	/// A process that does not answer a query within @a _queryTimeout is terminated and the query
+	/// is answered with `unknown`. A process that exits is replaced by a new one.
+	/// Zero processes restores the default of one process per query.
+	void setProcessPool(
+		size_t _processes,
+		std::optional<std::chrono::milliseconds> _queryTimeout = std::nullopt,
+		std::vector<std::string> _interactiveArguments = {"-in"}
+	);
 
 	/// Calls an SMT solver with the given query.
+	/// For the kind SMTSolverVersion the query is ignored and the version of the solver is returned instead.
 	frontend::ReadCallback::Result solve(std::string const& _kind, std::string const& _query);
 
 	frontend::ReadCallback::Callback solver()
@@ -39,8 +65,39 @@ public:
 	}
 
 private:
+	class Process;
+
+	/// @returns the path of the solver's binary or an empty path if it is not found.
+	boost::filesystem::path solverBinary() const;
+
+	/// @returns an identification of the version of the solver, made of the path, size and
+	/// modification time of @a _binary, which change whenever the solver is updated.
+	static frontend::ReadCallback::Result solverVersion(boost::filesystem::path const& _binary);
+
+	/// Solves the query with a new process that reads it from a temporary file.
+	frontend::ReadCallback::Result solveWithNewProcess(boost::filesystem::path const& _binary, std::string const& _query);
+	/// Solves the query with a process of the pool, retrying once if the process exits.
+	frontend::ReadCallback::Result solveWithProcessPool(boost::filesystem::path const& _binary, std::string const& _query);
+
+	/// Takes an idle process from the pool, starting a new one if the pool is not full yet,
+	/// and waits for one to become idle otherwise.
+	std::unique_ptr<Process> acquireProcess(boost::filesystem::path const& _binary);
+	/// Returns @a _process to the pool, or drops it if it is not running anymore.
+	void releaseProcess(std::unique_ptr<Process> _process);
+
 	/// The name of the solver's binary.
 	std::string const m_solverCmd;
+
+	size_t m_maxProcesses = 0;
+	std::optional<std::chrono::milliseconds> m_queryTimeout;
+	std::vector<std::string> m_interactiveArguments;
+
+	std::mutex m_poolMutex;
+	std::condition_variable m_processReleased;
+	/// Processes that are not answering a query at the moment.
+	std::vector<std::unique_ptr<Process>> m_idleProcesses;
+	/// Number of running processes, including the ones answering a query.
+	size_t m_liveProcesses = 0;
 };
 
 }
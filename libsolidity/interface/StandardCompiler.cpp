@@ -38,10 +38,12 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/MappedFile.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <optional>
 
 using namespace std;
@@ -83,6 +85,31 @@ Json::Value formatFatalError(Error::Type _type, string const& _message)
 	return output;
 }
 
+/// @returns the message of the internal compiler error that reports the exception currently handled.
+string currentExceptionMessage()
+{
+	try
+	{
+		throw;
+	}
+	catch (Json::LogicError const& _exception)
+	{
+		return string("JSON logic exception: ") + _exception.what();
+	}
+	catch (Json::RuntimeError const& _exception)
+	{
+		return string("JSON runtime exception: ") + _exception.what();
+	}
+	catch (util::Exception const& _exception)
+	{
+		return "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception);
+	}
+	catch (...)
+	{
+		return "Internal exception in StandardCompiler::compile: " + boost::current_exception_diagnostic_information();
+	}
+}
+
 Json::Value formatSourceLocation(SourceLocation const* location)
 {
 	if (!location || !location->sourceName)
@@ -180,6 +207,8 @@ bool hashMatchesContent(string const& _hash, string const& _content)
 bool isArtifactRequested(Json::Value const& _outputSelection, string const& _artifact, bool _wildcardMatchesExperimental)
 {
 	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast"};
+	// Repeats another artifact in a different encoding, so it is only output if requested by name.
+	static set<string> explicitOnly{"astBinary"};
 	for (auto const& selectedArtifactJson: _outputSelection)
 	{
 		string const& selectedArtifact = selectedArtifactJson.asString();
@@ -191,7 +220,7 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _art
 		else if (selectedArtifact == "*")
 		{
 			// "ir", "irOptimized", "wast" and "ewasm.wast" can only be matched by "*" if activated.
-			if (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
+			if (explicitOnly.count(_artifact) == 0 && (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental))
 				return true;
 		}
 	}
@@ -295,6 +324,20 @@ bool isEvmBytecodeRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the EVM assembly text, which quotes the sources, was requested.
+bool isEvmAssemblyRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& output: {"*", "evm.assembly"})
+				if (isArtifactRequested(requests, output, false))
+					return true;
+	return false;
+}
+
 /// @returns true if any Ewasm code was requested. Note that as an exception, '*' does not
 /// yet match "ewasm.wast" or "ewasm"
 bool isEwasmRequested(Json::Value const& _outputSelection)
@@ -330,6 +373,14 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns the file and the contract name of the fully qualified name @a _contractName.
+pair<string, string> splitContractName(string const& _contractName)
+{
+	size_t colon = _contractName.rfind(':');
+	solAssert(colon != string::npos, "");
+	return {_contractName.substr(0, colon), _contractName.substr(colon + 1)};
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret{Json::objectValue};
@@ -445,7 +496,7 @@ std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "showUnproved", "solvers", "targets", "timeout"};
+	static set<string> keys{"contracts", "divModNoSlacks", "engine", "extCalls", "incremental", "invariants", "portfolio", "showUnproved", "sliceQueries", "solvers", "statistics", "targets", "threads", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -677,7 +728,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = std::move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -694,7 +745,8 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 				ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), url.asString());
 				if (result.success)
 				{
-					if (!hash.empty() && !hashMatchesContent(hash, result.responseOrErrorMessage))
+					string content = result.file ? string(result.file->contents()) : std::move(result.responseOrErrorMessage);
+					if (!hash.empty() && !hashMatchesContent(hash, content))
 						ret.errors.append(formatError(
 							Error::Type::IOError,
 							"general",
@@ -702,7 +754,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 						));
 					else
 					{
-						ret.sources[sourceName] = result.responseOrErrorMessage;
+						ret.sources[sourceName] = std::move(content);
 						found = true;
 						break;
 					}
@@ -771,10 +823,12 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		if (!settings["stopAfter"].isString())
 			return formatFatalError(Error::Type::JSONError, "\"settings.stopAfter\" must be a string.");
 
-		if (settings["stopAfter"].asString() != "parsing")
-			return formatFatalError(Error::Type::JSONError, "Invalid value for \"settings.stopAfter\". Only valid value is \"parsing\".");
-
-		ret.stopAfter = CompilerStack::State::Parsed;
+		if (settings["stopAfter"].asString() == "parsing")
+			ret.stopAfter = CompilerStack::State::Parsed;
+		else if (settings["stopAfter"].asString() == "analysis")
+			ret.stopAfter = CompilerStack::State::AnalysisPerformed;
+		else
+			return formatFatalError(Error::Type::JSONError, "Invalid value for \"settings.stopAfter\". Valid values are \"parsing\" and \"analysis\".");
 	}
 
 	if (settings.isMember("parserErrorRecovery"))
@@ -1026,6 +1080,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.externalCalls = *extCalls;
 	}
 
+	if (modelCheckerSettings.isMember("incremental"))
+	{
+		auto const& incremental = modelCheckerSettings["incremental"];
+		if (!incremental.isBool())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.incremental must be a Boolean value.");
+		ret.modelCheckerSettings.incremental = incremental.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("invariants"))
 	{
 		auto const& invariantsArray = modelCheckerSettings["invariants"];
@@ -1047,6 +1109,16 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.invariants = invariants;
 	}
 
+	if (modelCheckerSettings.isMember("portfolio"))
+	{
+		if (!modelCheckerSettings["portfolio"].isString())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.portfolio must be a string.");
+		std::optional<ModelCheckerPortfolio> portfolio = ModelCheckerPortfolio::fromString(modelCheckerSettings["portfolio"].asString());
+		if (!portfolio)
+			return formatFatalError(Error::Type::JSONError, "Invalid model checker portfolio requested.");
+		ret.modelCheckerSettings.portfolio = *portfolio;
+	}
+
 	if (modelCheckerSettings.isMember("showUnproved"))
 	{
 		auto const& showUnproved = modelCheckerSettings["showUnproved"];
@@ -1055,6 +1127,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.showUnproved = showUnproved.asBool();
 	}
 
+	if (modelCheckerSettings.isMember("sliceQueries"))
+	{
+		auto const& sliceQueries = modelCheckerSettings["sliceQueries"];
+		if (!sliceQueries.isBool())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.sliceQueries must be a Boolean value.");
+		ret.modelCheckerSettings.sliceQueries = sliceQueries.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("solvers"))
 	{
 		auto const& solversArray = modelCheckerSettings["solvers"];
@@ -1073,6 +1153,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.solvers = solvers;
 	}
 
+	if (modelCheckerSettings.isMember("statistics"))
+	{
+		auto const& statistics = modelCheckerSettings["statistics"];
+		if (!statistics.isBool())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.statistics must be a Boolean value.");
+		ret.modelCheckerSettings.statistics = statistics.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("targets"))
 	{
 		auto const& targetsArray = modelCheckerSettings["targets"];
@@ -1094,6 +1182,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.targets = targets;
 	}
 
+	if (modelCheckerSettings.isMember("threads"))
+	{
+		if (!modelCheckerSettings["threads"].isUInt() || modelCheckerSettings["threads"].asUInt() == 0)
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.threads must be a positive integer.");
+		ret.modelCheckerSettings.threads = modelCheckerSettings["threads"].asUInt();
+	}
+
 	if (modelCheckerSettings.isMember("timeout"))
 	{
 		if (!modelCheckerSettings["timeout"].isUInt())
@@ -1104,12 +1199,17 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+StandardCompiler::SolidityCompilation StandardCompiler::compileSoliditySources(InputsAndSettings& _inputsAndSettings)
 {
-	CompilerStack compilerStack(m_readFile);
+	SolidityCompilation compilation;
+	compilation.compilerStack = make_unique<CompilerStack>(m_readFile);
+	CompilerStack& compilerStack = *compilation.compilerStack;
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
+	// The sources are only needed afterwards for the assembly text, otherwise they are moved.
+	if (isEvmAssemblyRequested(_inputsAndSettings.outputSelection))
+		compilerStack.setSources(_inputsAndSettings.sources);
+	else
+		compilerStack.setSources(std::move(_inputsAndSettings.sources));
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
@@ -1262,9 +1362,20 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		((binariesRequested && !compilationSuccess) || !analysisPerformed) &&
 		(errors.empty() && _inputsAndSettings.stopAfter >= CompilerStack::State::AnalysisPerformed)
 	)
-		return formatFatalError(Error::Type::InternalCompilerError, "No error reported, but compilation failed.");
+	{
+		compilation.output = formatFatalError(Error::Type::InternalCompilerError, "No error reported, but compilation failed.");
+		return compilation;
+	}
 
-	Json::Value output = Json::objectValue;
+	compilation.outputArtifacts = true;
+	compilation.analysisPerformed = analysisPerformed;
+	compilation.compilationSuccess = compilationSuccess;
+	compilation.sourcesParsed =
+		compilerStack.state() >= CompilerStack::State::Parsed &&
+		(!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery);
+
+	Json::Value& output = compilation.output;
+	output = Json::objectValue;
 
 	if (errors.size() > 0)
 		output["errors"] = std::move(errors);
@@ -1273,116 +1384,214 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
 
-	bool const wildcardMatchesExperimental = false;
+	if (
+		_inputsAndSettings.modelCheckerSettings.portfolio.isConcurrent() ||
+		_inputsAndSettings.modelCheckerSettings.statistics
+	)
+		for (auto const& [engine, solvers]: compilerStack.modelCheckerSolverStatistics())
+			for (auto const& [solver, statistics]: solvers)
+			{
+				Json::Value& solverOutput = output["modelChecker"]["statistics"]["solvers"][engine][solver];
+				solverOutput["queries"] = Json::UInt64(statistics.queries);
+				solverOutput["answers"] = Json::UInt64(statistics.answers);
+				solverOutput["wins"] = Json::UInt64(statistics.wins);
+				solverOutput["time"] = Json::Int64(chrono::duration_cast<chrono::milliseconds>(statistics.time).count());
+				if (statistics.queryBytes > 0)
+				{
+					solverOutput["queryBytes"] = Json::UInt64(statistics.queryBytes);
+					solverOutput["largestQueryBytes"] = Json::UInt64(statistics.largestQueryBytes);
+				}
+				solverOutput["assertedNodes"] = Json::UInt64(statistics.assertedNodes);
+			}
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
-		for (string const& sourceName: compilerStack.sourceNames())
+	if (_inputsAndSettings.modelCheckerSettings.sliceQueries)
+	{
+		auto const& statistics = compilerStack.modelCheckerSlicingStatistics();
+		Json::Value& slicingOutput = output["modelChecker"]["statistics"]["slicing"];
+		slicingOutput["queries"] = Json::UInt64(statistics.queries);
+		slicingOutput["conjuncts"] = Json::UInt64(statistics.conjuncts);
+		slicingOutput["keptConjuncts"] = Json::UInt64(statistics.keptConjuncts);
+		slicingOutput["nodes"] = Json::UInt64(statistics.nodes);
+		slicingOutput["keptNodes"] = Json::UInt64(statistics.keptNodes);
+	}
+
+	if (_inputsAndSettings.modelCheckerSettings.statistics)
+	{
+		Json::Value& targetsOutput = output["modelChecker"]["statistics"]["targets"];
+		targetsOutput = Json::arrayValue;
+		for (auto const& target: compilerStack.modelCheckerTargetStatistics())
 		{
-			Json::Value sourceResult = Json::objectValue;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
+			Json::Value targetOutput;
+			targetOutput["engine"] = target.engine;
+			targetOutput["type"] = target.typeString();
+			targetOutput["sourceLocation"]["file"] = target.location.sourceName ? *target.location.sourceName : "";
+			targetOutput["sourceLocation"]["start"] = target.location.start;
+			targetOutput["sourceLocation"]["end"] = target.location.end;
+			targetOutput["function"] = target.function;
+			targetOutput["solver"] = target.solver;
+			if (target.queryBytes > 0)
+				targetOutput["queryBytes"] = Json::UInt64(target.queryBytes);
+			targetOutput["time"] = Json::Int64(chrono::duration_cast<chrono::milliseconds>(target.time).count());
+			targetOutput["result"] = target.resultString();
+			if (!target.unknownReason.empty())
+				targetOutput["unknownReason"] = target.unknownReason;
+			targetsOutput.append(std::move(targetOutput));
 		}
+	}
 
-	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
-	{
-		size_t colon = contractName.rfind(':');
-		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
-
-		// ABI, storage layout, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-
-		// Ewasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
-
-		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				_inputsAndSettings.evmVersion,
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.bytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+	return compilation;
+}
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				_inputsAndSettings.evmVersion,
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.deployedBytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+Json::Value StandardCompiler::soliditySourceOutput(
+	SolidityCompilation const& _compilation,
+	InputsAndSettings const& _inputsAndSettings,
+	string const& _sourceName,
+	unsigned _sourceIndex
+)
+{
+	bool const wildcardMatchesExperimental = false;
+	CompilerStack const& compilerStack = *_compilation.compilerStack;
+	auto typeProviderScope = compilerStack.typeProviderScope();
+
+	Json::Value sourceResult = Json::objectValue;
+	sourceResult["id"] = _sourceIndex;
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, _sourceName, "", "ast", wildcardMatchesExperimental))
+		sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(_sourceName));
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, _sourceName, "", "astBinary", wildcardMatchesExperimental))
+	{
+		// Wrapped like the sources of this output, so that the decoded file can be passed to --import-ast.
+		Json::Value astFile = Json::objectValue;
+		astFile["sources"][_sourceName]["ast"] = sourceResult.isMember("ast") ?
+			sourceResult["ast"] :
+			ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(_sourceName));
+		sourceResult["astBinary"] = util::toHex(util::asBytes(util::jsonBinaryPrint(astFile)));
+	}
+	return sourceResult;
+}
+
+Json::Value StandardCompiler::solidityContractOutput(
+	SolidityCompilation const& _compilation,
+	InputsAndSettings const& _inputsAndSettings,
+	string const& _contractName
+)
+{
+	bool const wildcardMatchesExperimental = false;
+	CompilerStack const& compilerStack = *_compilation.compilerStack;
+	auto typeProviderScope = compilerStack.typeProviderScope();
+	bool const compilationSuccess = _compilation.compilationSuccess;
+	string file;
+	string name;
+	tie(file, name) = splitContractName(_contractName);
+
+	// ABI, storage layout, documentation and metadata
+	Json::Value contractData(Json::objectValue);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
+		contractData["abi"] = compilerStack.contractABI(_contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
+		contractData["storageLayout"] = compilerStack.storageLayout(_contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+		contractData["metadata"] = compilerStack.metadata(_contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
+		contractData["userdoc"] = compilerStack.natspecUser(_contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
+		contractData["devdoc"] = compilerStack.natspecDev(_contractName);
+
+	// IR
+	if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+		contractData["ir"] = compilerStack.yulIR(_contractName);
+	if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+		contractData["irOptimized"] = compilerStack.yulIROptimized(_contractName);
+
+	// Ewasm
+	if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
+		contractData["ewasm"]["wast"] = compilerStack.ewasm(_contractName);
+	if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
+		contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(_contractName).toHex();
+
+	// EVM
+	Json::Value evmData(Json::objectValue);
+	if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+		evmData["assembly"] = compilerStack.assemblyString(_contractName, _inputsAndSettings.sources);
+	if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+		evmData["legacyAssembly"] = compilerStack.assemblyJSON(_contractName);
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+		evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(_contractName)["methods"];
+	if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+		evmData["gasEstimates"] = compilerStack.gasEstimates(_contractName);
+
+	if (compilationSuccess && isArtifactRequested(
+		_inputsAndSettings.outputSelection,
+		file,
+		name,
+		evmObjectComponents("bytecode"),
+		wildcardMatchesExperimental
+	))
+		evmData["bytecode"] = collectEVMObject(
+			_inputsAndSettings.evmVersion,
+			compilerStack.object(_contractName),
+			compilerStack.sourceMapping(_contractName),
+			compilerStack.generatedSources(_contractName),
+			false,
+			[&](string const& _element) { return isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				"evm.bytecode." + _element,
+				wildcardMatchesExperimental
+			); }
+		);
+
+	if (compilationSuccess && isArtifactRequested(
+		_inputsAndSettings.outputSelection,
+		file,
+		name,
+		evmObjectComponents("deployedBytecode"),
+		wildcardMatchesExperimental
+	))
+		evmData["deployedBytecode"] = collectEVMObject(
+			_inputsAndSettings.evmVersion,
+			compilerStack.runtimeObject(_contractName),
+			compilerStack.runtimeSourceMapping(_contractName),
+			compilerStack.generatedSources(_contractName, true),
+			true,
+			[&](string const& _element) { return isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				"evm.deployedBytecode." + _element,
+				wildcardMatchesExperimental
+			); }
+		);
+
+	if (!evmData.empty())
+		contractData["evm"] = evmData;
+
+	return contractData;
+}
+
+Json::Value StandardCompiler::compileSolidity(InputsAndSettings _inputsAndSettings)
+{
+	SolidityCompilation compilation = compileSoliditySources(_inputsAndSettings);
+	if (!compilation.outputArtifacts)
+		return std::move(compilation.output);
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+	Json::Value output = std::move(compilation.output);
+	CompilerStack const& compilerStack = *compilation.compilerStack;
+
+	output["sources"] = Json::objectValue;
+	unsigned sourceIndex = 0;
+	if (compilation.sourcesParsed)
+		for (string const& sourceName: compilerStack.sourceNames())
+			output["sources"][sourceName] = soliditySourceOutput(compilation, _inputsAndSettings, sourceName, sourceIndex++);
 
+	Json::Value contractsOutput = Json::objectValue;
+	for (string const& contractName: compilation.analysisPerformed ? compilerStack.contractNames() : vector<string>())
+	{
+		Json::Value contractData = solidityContractOutput(compilation, _inputsAndSettings, contractName);
 		if (!contractData.empty())
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			auto [file, name] = splitContractName(contractName);
+			contractsOutput[file][name] = std::move(contractData);
 		}
 	}
 	if (!contractsOutput.empty())
@@ -1391,6 +1600,100 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	return output;
 }
 
+void StandardCompiler::compileSolidity(InputsAndSettings _inputsAndSettings, util::JsonStreamWriter& _writer)
+{
+	SolidityCompilation compilation = compileSoliditySources(_inputsAndSettings);
+	if (!compilation.outputArtifacts)
+	{
+		_writer.value(compilation.output);
+		return;
+	}
+
+	Json::Value const& output = compilation.output;
+	CompilerStack const& compilerStack = *compilation.compilerStack;
+
+	// The contracts are grouped by file and, like all members, written in the order of their names.
+	map<string, map<string, string>> contractsByFile;
+	if (compilation.analysisPerformed)
+		for (string const& contractName: compilerStack.contractNames())
+		{
+			auto [file, name] = splitContractName(contractName);
+			contractsByFile[file][name] = contractName;
+		}
+
+	// Writes the members of the output that were already generated and precede @a _name, or all remaining ones.
+	vector<string> const otherMembers = output.getMemberNames();
+	auto nextOtherMember = otherMembers.begin();
+	auto writeOtherMembersBefore = [&](optional<string> const& _name) {
+		for (; nextOtherMember != otherMembers.end() && (!_name || *nextOtherMember < *_name); ++nextOtherMember)
+			_writer.member(*nextOtherMember, output[*nextOtherMember]);
+	};
+
+	size_t const depth = _writer.depth();
+	_writer.beginObject();
+	try
+	{
+		writeOtherMembersBefore("contracts");
+		bool contractsWritten = false;
+		for (auto const& [file, contracts]: contractsByFile)
+		{
+			bool fileWritten = false;
+			for (auto const& [name, contractName]: contracts)
+			{
+				Json::Value contractData = solidityContractOutput(compilation, _inputsAndSettings, contractName);
+				if (contractData.empty())
+					continue;
+				if (!contractsWritten)
+				{
+					_writer.key("contracts");
+					_writer.beginObject();
+					contractsWritten = true;
+				}
+				if (!fileWritten)
+				{
+					_writer.key(file);
+					_writer.beginObject();
+					fileWritten = true;
+				}
+				_writer.member(name, contractData);
+			}
+			if (fileWritten)
+				_writer.endObject();
+		}
+		if (contractsWritten)
+			_writer.endObject();
+
+		// The sources are generated before the errors are written, so that their errors can still be reported.
+		vector<pair<string, Json::Value>> sources;
+		unsigned sourceIndex = 0;
+		if (compilation.sourcesParsed)
+			for (string const& sourceName: compilerStack.sourceNames())
+				sources.emplace_back(sourceName, soliditySourceOutput(compilation, _inputsAndSettings, sourceName, sourceIndex++));
+
+		writeOtherMembersBefore("sources");
+		_writer.key("sources");
+		_writer.beginObject();
+		for (auto const& [sourceName, sourceOutput]: sources)
+			_writer.member(sourceName, sourceOutput);
+		_writer.endObject();
+
+		writeOtherMembersBefore(nullopt);
+		_writer.endObject();
+	}
+	catch (...)
+	{
+		// Part of the output was written already. The open objects are ended and the error is
+		// reported in the errors member, unless that was written already.
+		_writer.endAfterError(depth + 1);
+		if (_writer.lastKey() && *_writer.lastKey() >= "errors")
+			throw;
+		Json::Value errors = output.isMember("errors") ? output["errors"] : Json::Value(Json::arrayValue);
+		errors.append(formatError(Error::Type::InternalCompilerError, "general", currentExceptionMessage()));
+		_writer.member("errors", errors);
+		_writer.endObject();
+	}
+}
+
 
 Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 {
@@ -1529,65 +1832,89 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compile([&]() { return parseInput(_input); }, nullptr);
+}
+
+Json::Value StandardCompiler::compile(
+	function<variant<InputsAndSettings, Json::Value>()> const& _parseInput,
+	util::JsonStreamWriter* _writer
+) noexcept
 {
 	YulStringRepository::reset();
 
 	try
 	{
-		auto parsed = parseInput(_input);
+		auto parsed = _parseInput();
 		if (std::holds_alternative<Json::Value>(parsed))
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
+		if (settings.language == "Solidity" && _writer)
+		{
+			compileSolidity(std::move(settings), *_writer);
+			return Json::nullValue;
+		}
+		else if (settings.language == "Solidity")
 			return compileSolidity(std::move(settings));
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
 			return formatFatalError(Error::Type::JSONError, "Only \"Solidity\" or \"Yul\" is supported as a language.");
 	}
-	catch (Json::LogicError const& _exception)
-	{
-		return formatFatalError(Error::Type::InternalCompilerError, string("JSON logic exception: ") + _exception.what());
-	}
-	catch (Json::RuntimeError const& _exception)
-	{
-		return formatFatalError(Error::Type::InternalCompilerError, string("JSON runtime exception: ") + _exception.what());
-	}
-	catch (util::Exception const& _exception)
-	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
-	}
 	catch (...)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+		return formatFatalError(Error::Type::InternalCompilerError, currentExceptionMessage());
 	}
 }
 
 string StandardCompiler::compile(string const& _input) noexcept
+{
+	ostringstream output;
+	compile(_input, output);
+	return output.str();
+}
+
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
 {
 	Json::Value input;
 	string errors;
 	try
 	{
 		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+		{
+			_output << util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+			return;
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
 	}
 
-	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
+	auto parseAndReleaseInput = [&]() {
+		auto parsed = parseInput(input);
+		// The sources were copied out of the input, which is not needed anymore.
+		input = Json::Value();
+		return parsed;
+	};
 
 	try
 	{
-		return util::jsonPrint(output, m_jsonPrintingFormat);
+		if (m_jsonPrintingFormat.format == util::JsonFormat::Compact)
+		{
+			util::JsonStreamWriter writer(_output);
+			Json::Value output = compile(parseAndReleaseInput, &writer);
+			// An error that occurs after part of the output was written is reported by compileSolidity.
+			if (!writer.started())
+				writer.value(output);
+		}
+		else
+			_output << util::jsonPrint(compile(parseAndReleaseInput, nullptr), m_jsonPrintingFormat);
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
 
@@ -28,7 +28,10 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <functional>
+#include <memory>
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -62,6 +65,11 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but writes the output to @a _output. In the compact format, the output of
+	/// Solidity sources is written one source and one contract at a time as it is generated,
+	/// instead of being built as a whole first. The output is the same either way, except if an
+	/// internal error occurs after part of it was written, in which case it is cut short.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
 
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -91,11 +99,47 @@ private:
 		bool viaIR = false;
 	};
 
+	/// The result of compiling Solidity sources, from which the output is generated.
+	struct SolidityCompilation
+	{
+		std::unique_ptr<CompilerStack> compilerStack;
+		/// The output other than the sources and the contracts, or the whole output if not @a outputArtifacts.
+		Json::Value output;
+		bool outputArtifacts = false;
+		bool analysisPerformed = false;
+		bool compilationSuccess = false;
+		/// Whether the sources are part of the output.
+		bool sourcesParsed = false;
+	};
+
+	/// Performs the compilation of the input returned by @a _parseInput. If @a _writer is not null,
+	/// the output of Solidity sources is written there and null is returned, unless an error
+	/// occurs before anything is written.
+	Json::Value compile(
+		std::function<std::variant<InputsAndSettings, Json::Value>()> const& _parseInput,
+		util::JsonStreamWriter* _writer
+	) noexcept;
+
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
+	SolidityCompilation compileSoliditySources(InputsAndSettings& _inputsAndSettings);
+	static Json::Value soliditySourceOutput(
+		SolidityCompilation const& _compilation,
+		InputsAndSettings const& _inputsAndSettings,
+		std::string const& _sourceName,
+		unsigned _sourceIndex
+	);
+	/// @returns the artifacts of a contract, which are empty if none were requested.
+	static Json::Value solidityContractOutput(
+		SolidityCompilation const& _compilation,
+		InputsAndSettings const& _inputsAndSettings,
+		std::string const& _contractName
+	);
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Writes the output to @a _writer, generating the artifacts of a contract only when it is written.
+	void compileSolidity(InputsAndSettings _inputsAndSettings, util::JsonStreamWriter& _writer);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
@@ -39,7 +39,10 @@ public:
 		return [this](std::string const& _kind, std::string const& _data) -> ReadCallback::Result {
 			if (_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile))
 				return m_fileReader.readFile(_kind, _data);
-			else if (_kind == ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
+			else if (
+				_kind == ReadCallback::kindString(ReadCallback::Kind::SMTQuery) ||
+				_kind == ReadCallback::kindString(ReadCallback::Kind::SMTSolverVersion)
+			)
 				return m_solver.solve(_kind, _data);
 			solAssert(false, "Unknown callback kind.");
 		};
@@ -331,6 +331,8 @@ void LanguageServer::compileAndUpdateDiagnostics()
 
 bool LanguageServer::run()
 {
+	// The handlers use the types of the analysed sources.
+	auto typeProviderScope = m_compilerStack.typeProviderScope();
 	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
 	{
 		MessageID id;
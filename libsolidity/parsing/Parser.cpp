@@ -37,6 +37,7 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <cctype>
+#include <mutex>
 #include <vector>
 #include <regex>
 #include <tuple>
@@ -74,7 +75,7 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.allocateNode<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -84,6 +85,15 @@ private:
 	SourceLocation m_location;
 };
 
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	solAssert(m_recordCreatedNodes || _offset == 0, "");
+	for (auto const& createdNode: m_createdNodes)
+		if (auto node = createdNode.lock())
+			node->m_id = static_cast<size_t>(node->id() + _offset);
+	m_currentNodeID += _offset;
+}
+
 ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 {
 	solAssert(!m_insideModifier, "");
@@ -91,6 +101,8 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	{
 		m_recursionDepth = 0;
 		m_scanner = make_shared<Scanner>(_charStream);
+		m_arena = make_shared<ASTArena>();
+		m_createdNodes.clear();
 		ASTNodeFactory nodeFactory(*this);
 
 		vector<ASTPointer<ASTNode>> nodes;
@@ -1386,6 +1398,9 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 {
 	RecursionGuard recursionGuard(*this);
 	SourceLocation location = currentLocation();
+	// The Yul dialects and the repository of YulStrings are shared and not thread-safe.
+	static mutex inlineAssemblyMutex;
+	lock_guard<mutex> lock(inlineAssemblyMutex);
 
 	expectToken(Token::Assembly);
 	yul::Dialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
@@ -1418,7 +1433,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(*block).end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), block);
+	return allocateNode<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), block);
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -2194,9 +2209,10 @@ optional<string> Parser::findLicenseString(std::vector<ASTPointer<ASTNode>> cons
 
 	// Search inside all parts of the source not covered by parsed nodes.
 	// This will leave e.g. "global comments".
-	using iter = std::string::const_iterator;
+	using iter = std::string_view::const_iterator;
+	using regexIterator = std::regex_iterator<iter>;
 	vector<pair<iter, iter>> sequencesToSearch;
-	string const& source = m_scanner->charStream().source();
+	string_view source = m_scanner->charStream().source();
 	sequencesToSearch.emplace_back(source.begin(), source.end());
 	for (ASTPointer<ASTNode> const& node: _nodes)
 		if (node->location().hasText())
@@ -2208,10 +2224,10 @@ optional<string> Parser::findLicenseString(std::vector<ASTPointer<ASTNode>> cons
 	vector<string> licenseNames;
 	for (auto const& [start, end]: sequencesToSearch)
 	{
-		auto declarationsBegin = std::sregex_iterator(start, end, licenseDeclarationRegex);
-		auto declarationsEnd = std::sregex_iterator();
+		auto declarationsBegin = regexIterator(start, end, licenseDeclarationRegex);
+		auto declarationsEnd = regexIterator();
 
-		for (std::sregex_iterator declIt = declarationsBegin; declIt != declarationsEnd; ++declIt)
+		for (regexIterator declIt = declarationsBegin; declIt != declarationsEnd; ++declIt)
 			if (!declIt->empty())
 			{
 				string license = boost::trim_copy(string((*declIt)[1]));
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTArena.h>
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
 
@@ -49,6 +50,15 @@ public:
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
 
+	/// @returns the ID of the last node created by this parser.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+	/// Makes parse keep track of the nodes it creates, which is required by shiftNodeIDs.
+	void recordCreatedNodes() { m_recordCreatedNodes = true; }
+	/// Adds @a _offset to the IDs of the nodes created by the last call to parse and to the
+	/// ID of the last node. Used to number the nodes of sources parsed concurrently by
+	/// different parsers as if they were parsed one after the other by one parser.
+	void shiftNodeIDs(int64_t _offset);
+
 private:
 	class ASTNodeFactory;
 
@@ -221,11 +231,27 @@ private:
 	/// Creates an empty ParameterList at the current location (used if parameters can be omitted).
 	ASTPointer<ParameterList> createEmptyParameterList();
 
+	/// @returns a new node of type @a NodeType allocated from the arena of the current source unit.
+	template <class NodeType, typename... Args>
+	ASTPointer<NodeType> allocateNode(Args&& ... _args)
+	{
+		auto node = std::allocate_shared<NodeType>(ASTArenaAllocator<NodeType>(m_arena), std::forward<Args>(_args)...);
+		if (m_recordCreatedNodes)
+			m_createdNodes.emplace_back(node);
+		return node;
+	}
+
 	/// Flag that signifies whether '_' is parsed as a PlaceholderStatement or a regular identifier.
 	bool m_insideModifier = false;
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Memory of the nodes of the source unit being parsed.
+	std::shared_ptr<ASTArena> m_arena;
+	bool m_recordCreatedNodes = false;
+	/// Nodes created by the last call to parse if m_recordCreatedNodes is set,
+	/// some of which might have been discarded.
+	std::vector<std::weak_ptr<ASTNode>> m_createdNodes;
 };
 
 }
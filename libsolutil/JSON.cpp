@@ -22,10 +22,12 @@
 
 #include <libsolutil/JSON.h>
 
+#include <libsolutil/Assertions.h>
 #include <libsolutil/CommonIO.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
+#include <cstring>
 #include <sstream>
 #include <map>
 #include <memory>
@@ -140,10 +142,405 @@ string jsonPrint(Json::Value const& _input, JsonFormat const& _format)
 	return result;
 }
 
+void JsonStreamWriter::beginObject()
+{
+	m_output << separator() + "{";
+	valueWritten();
+	m_scopes.push_back({true, true, nullopt});
+}
+
+void JsonStreamWriter::endObject()
+{
+	assertThrow(!m_scopes.empty() && m_scopes.back().isObject, JsonStreamWriterError, "No object to end.");
+	assertThrow(!m_keyWritten, JsonStreamWriterError, "Member without value.");
+	m_output << '}';
+	m_scopes.pop_back();
+}
+
+void JsonStreamWriter::beginArray()
+{
+	m_output << separator() + "[";
+	valueWritten();
+	m_scopes.push_back({false, true, nullopt});
+}
+
+void JsonStreamWriter::endArray()
+{
+	assertThrow(!m_scopes.empty() && !m_scopes.back().isObject, JsonStreamWriterError, "No array to end.");
+	m_output << ']';
+	m_scopes.pop_back();
+}
+
+void JsonStreamWriter::key(string const& _name)
+{
+	assertThrow(!m_scopes.empty() && m_scopes.back().isObject, JsonStreamWriterError, "Key outside of an object.");
+	assertThrow(!m_keyWritten, JsonStreamWriterError, "Member without value.");
+	Scope& scope = m_scopes.back();
+	assertThrow(!scope.lastKey || *scope.lastKey < _name, JsonStreamWriterError, "Members not ordered by name: " + _name);
+	// Quote the name the same way as jsoncpp quotes strings.
+	m_output << (scope.empty ? "" : ",") + jsonCompactPrint(Json::Value(_name)) + ":";
+	scope.empty = false;
+	scope.lastKey = _name;
+	m_keyWritten = true;
+}
+
+void JsonStreamWriter::value(Json::Value const& _value)
+{
+	m_output << separator() + jsonCompactPrint(_value);
+	valueWritten();
+}
+
+void JsonStreamWriter::endAfterError(size_t _depth)
+{
+	assertThrow(_depth <= m_scopes.size(), JsonStreamWriterError, "Not enough open objects and arrays.");
+	m_output.clear();
+	if (m_keyWritten)
+		value(Json::nullValue);
+	while (m_scopes.size() > _depth)
+		if (m_scopes.back().isObject)
+			endObject();
+		else
+			endArray();
+}
+
+string JsonStreamWriter::separator() const
+{
+	if (m_scopes.empty())
+		assertThrow(!m_started, JsonStreamWriterError, "More than one top-level value.");
+	else if (m_scopes.back().isObject)
+		assertThrow(m_keyWritten, JsonStreamWriterError, "Object member without key.");
+	else if (!m_scopes.back().empty)
+		return ",";
+	return "";
+}
+
+void JsonStreamWriter::valueWritten()
+{
+	if (m_scopes.empty())
+		m_started = true;
+	else if (m_scopes.back().isObject)
+		m_keyWritten = false;
+	else
+		m_scopes.back().empty = false;
+}
+
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
 {
 	static StrictModeCharReaderBuilder readerBuilder;
 	return parse(readerBuilder, _input, _json, _errs);
 }
 
+namespace
+{
+
+/// Header of documents created by jsonBinaryPrint: magic bytes followed by a format version.
+char const binaryJsonMagic[] = {'\0', 'S', 'J', 'B'};
+uint8_t const binaryJsonVersion = 1;
+/// Same nesting limit as used by the strict-mode JSON reader.
+size_t const binaryJsonMaxDepth = 1000;
+
+enum class BinaryJsonTag: uint8_t
+{
+	Null,
+	False,
+	True,
+	Int,
+	UInt,
+	Real,
+	String,
+	Array,
+	Object
+};
+
+void appendVarint(string& _output, uint64_t _value)
+{
+	while (_value > 0x7f)
+	{
+		_output += char(0x80 | (_value & 0x7f));
+		_value >>= 7;
+	}
+	_output += char(_value);
+}
+
+/// Writes the body of the document while collecting the string table.
+class BinaryJsonWriter
+{
+public:
+	string write(Json::Value const& _input)
+	{
+		encode(_input);
+
+		string result(binaryJsonMagic, sizeof(binaryJsonMagic));
+		result += char(binaryJsonVersion);
+		appendVarint(result, m_strings.size());
+		for (string_view str: m_strings)
+		{
+			appendVarint(result, str.size());
+			result += str;
+		}
+		result += m_body;
+		return result;
+	}
+
+private:
+	void encode(Json::Value const& _value)
+	{
+		switch (_value.type())
+		{
+		case Json::nullValue:
+			appendTag(BinaryJsonTag::Null);
+			break;
+		case Json::booleanValue:
+			appendTag(_value.asBool() ? BinaryJsonTag::True : BinaryJsonTag::False);
+			break;
+		case Json::intValue:
+		{
+			// Zig-zag encoding, so that small negative numbers stay short.
+			Json::LargestInt value = _value.asLargestInt();
+			appendTag(BinaryJsonTag::Int);
+			appendVarint(m_body, (uint64_t(value) << 1) ^ uint64_t(value >> 63));
+			break;
+		}
+		case Json::uintValue:
+			appendTag(BinaryJsonTag::UInt);
+			appendVarint(m_body, _value.asLargestUInt());
+			break;
+		case Json::realValue:
+		{
+			double value = _value.asDouble();
+			uint64_t bits = 0;
+			memcpy(&bits, &value, sizeof(bits));
+			appendTag(BinaryJsonTag::Real);
+			for (size_t i = 0; i < sizeof(bits); ++i)
+				m_body += char((bits >> (8 * i)) & 0xff);
+			break;
+		}
+		case Json::stringValue:
+		{
+			char const* begin = nullptr;
+			char const* end = nullptr;
+			_value.getString(&begin, &end);
+			appendTag(BinaryJsonTag::String);
+			appendVarint(m_body, stringIndex(string_view(begin, size_t(end - begin))));
+			break;
+		}
+		case Json::arrayValue:
+			appendTag(BinaryJsonTag::Array);
+			appendVarint(m_body, _value.size());
+			for (Json::Value const& element: _value)
+				encode(element);
+			break;
+		case Json::objectValue:
+			appendTag(BinaryJsonTag::Object);
+			appendVarint(m_body, _value.size());
+			for (auto it = _value.begin(); it != _value.end(); ++it)
+			{
+				char const* end = nullptr;
+				char const* begin = it.memberName(&end);
+				appendVarint(m_body, stringIndex(string_view(begin, size_t(end - begin))));
+				encode(*it);
+			}
+			break;
+		}
+	}
+
+	void appendTag(BinaryJsonTag _tag) { m_body += char(_tag); }
+
+	size_t stringIndex(string_view _str)
+	{
+		auto it = m_stringIndices.find(_str);
+		if (it == m_stringIndices.end())
+		{
+			it = m_stringIndices.emplace(string(_str), m_strings.size()).first;
+			m_strings.emplace_back(it->first);
+		}
+		return it->second;
+	}
+
+	string m_body;
+	map<string, size_t, less<>> m_stringIndices;
+	/// Strings in the order of their first occurrence, pointing into the keys of m_stringIndices.
+	vector<string_view> m_strings;
+};
+
+struct BinaryJsonParseError
+{
+	string message;
+};
+
+class BinaryJsonReader
+{
+public:
+	explicit BinaryJsonReader(string_view _input): m_input(_input) {}
+
+	void read(Json::Value& _json)
+	{
+		if (!isJsonBinary(m_input))
+			fail("Missing binary JSON header.");
+		m_position = sizeof(binaryJsonMagic);
+		if (readByte() != binaryJsonVersion)
+			fail("Unsupported binary JSON version.");
+
+		size_t stringCount = readLength();
+		m_strings.reserve(stringCount);
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			size_t length = readLength();
+			m_strings.emplace_back(m_input.substr(m_position, length));
+			m_position += length;
+		}
+
+		decode(_json, 0);
+		if (m_position != m_input.size())
+			fail("Unexpected data after the end of the document.");
+	}
+
+private:
+	void decode(Json::Value& _value, size_t _depth)
+	{
+		if (_depth > binaryJsonMaxDepth)
+			fail("Exceeded the nesting limit.");
+
+		switch (BinaryJsonTag(readByte()))
+		{
+		case BinaryJsonTag::Null:
+			_value = Json::Value();
+			break;
+		case BinaryJsonTag::False:
+			_value = false;
+			break;
+		case BinaryJsonTag::True:
+			_value = true;
+			break;
+		case BinaryJsonTag::Int:
+		{
+			uint64_t encoded = readVarint();
+			_value = Json::Value(Json::LargestInt((encoded >> 1) ^ (~(encoded & 1) + 1)));
+			break;
+		}
+		case BinaryJsonTag::UInt:
+			_value = Json::Value(Json::LargestUInt(readVarint()));
+			break;
+		case BinaryJsonTag::Real:
+		{
+			uint64_t bits = 0;
+			for (size_t i = 0; i < sizeof(bits); ++i)
+				bits |= uint64_t(readByte()) << (8 * i);
+			double value = 0;
+			memcpy(&value, &bits, sizeof(value));
+			_value = Json::Value(value);
+			break;
+		}
+		case BinaryJsonTag::String:
+		{
+			string_view str = readString();
+			_value = Json::Value(str.data(), str.data() + str.size());
+			break;
+		}
+		case BinaryJsonTag::Array:
+		{
+			size_t size = readLength();
+			_value = Json::Value(Json::arrayValue);
+			_value.resize(Json::ArrayIndex(size));
+			for (size_t i = 0; i < size; ++i)
+				decode(_value[Json::ArrayIndex(i)], _depth + 1);
+			break;
+		}
+		case BinaryJsonTag::Object:
+		{
+			size_t size = readLength();
+			_value = Json::Value(Json::objectValue);
+			for (size_t i = 0; i < size; ++i)
+			{
+				string_view name = readString();
+				decode(*_value.demand(name.data(), name.data() + name.size()), _depth + 1);
+			}
+			if (_value.size() != size)
+				fail("Duplicate member name.");
+			break;
+		}
+		default:
+			fail("Invalid value tag.");
+		}
+	}
+
+	uint8_t readByte()
+	{
+		if (m_position >= m_input.size())
+			fail("Unexpected end of input.");
+		return uint8_t(m_input[m_position++]);
+	}
+
+	uint64_t readVarint()
+	{
+		uint64_t result = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7)
+		{
+			uint8_t byte = readByte();
+			if (shift == 63 && byte > 1)
+				fail("Integer out of range.");
+			result |= uint64_t(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return result;
+		}
+		fail("Integer out of range.");
+	}
+
+	/// Reads the length of a string or the number of elements of an array or object.
+	/// Each of them occupies at least one byte, which bounds allocations by the input size.
+	size_t readLength()
+	{
+		uint64_t length = readVarint();
+		if (length > m_input.size() - m_position)
+			fail("Unexpected end of input.");
+		return size_t(length);
+	}
+
+	string_view readString()
+	{
+		uint64_t index = readVarint();
+		if (index >= m_strings.size())
+			fail("Invalid string index.");
+		return m_strings[size_t(index)];
+	}
+
+	[[noreturn]] void fail(string _message)
+	{
+		throw BinaryJsonParseError{"Offset " + to_string(m_position) + ": " + std::move(_message)};
+	}
+
+	string_view m_input;
+	size_t m_position = 0;
+	vector<string_view> m_strings;
+};
+
+}
+
+string jsonBinaryPrint(Json::Value const& _input)
+{
+	return BinaryJsonWriter{}.write(_input);
+}
+
+bool isJsonBinary(string_view _input)
+{
+	return
+		_input.size() >= sizeof(binaryJsonMagic) &&
+		_input.substr(0, sizeof(binaryJsonMagic)) == string_view(binaryJsonMagic, sizeof(binaryJsonMagic));
+}
+
+bool jsonBinaryParse(string_view _input, Json::Value& _json, string* _errs /* = nullptr */)
+{
+	try
+	{
+		BinaryJsonReader{_input}.read(_json);
+		return true;
+	}
+	catch (BinaryJsonParseError const& _error)
+	{
+		if (_errs)
+			*_errs = _error.message;
+		return false;
+	}
+}
+
 } // namespace solidity::util
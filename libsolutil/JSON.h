@@ -23,9 +23,15 @@
 
 #pragma once
 
+#include <libsolutil/Exceptions.h>
+
 #include <json/json.h>
 
+#include <optional>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace solidity::util
 {
@@ -60,6 +66,69 @@ std::string jsonCompactPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format);
 
+DEV_SIMPLE_EXCEPTION(JsonStreamWriterError);
+
+/// Writes compact JSON to a stream piece by piece, so that a large document does not have to
+/// be held in memory as a whole. The output is the same as that of jsonCompactPrint for the
+/// equivalent Json::Value. Since Json::Value orders the members of an object by name,
+/// the members of an object have to be written in that order.
+class JsonStreamWriter
+{
+public:
+	explicit JsonStreamWriter(std::ostream& _output): m_output(_output) {}
+
+	void beginObject();
+	void endObject();
+	void beginArray();
+	void endArray();
+	/// Writes the name of the next member of the current object.
+	void key(std::string const& _name);
+	/// Writes @a _value as a whole, as the next element of the current array,
+	/// as the value of the last key or as the top-level value.
+	void value(Json::Value const& _value);
+	/// Writes the member @a _name with value @a _value.
+	void member(std::string const& _name, Json::Value const& _value)
+	{
+		key(_name);
+		value(_value);
+	}
+
+	/// Ends the open objects and arrays until @a _depth of them are left, so that the output
+	/// can be completed after an exception. A key without value gets the value null. The error
+	/// state of the stream is cleared first, since the exception may have come from it.
+	void endAfterError(size_t _depth);
+
+	/// @returns true if anything was written.
+	bool started() const { return m_started; }
+	/// @returns the number of open objects and arrays.
+	size_t depth() const { return m_scopes.size(); }
+	/// @returns the name of the last member written to the innermost open object, if any.
+	std::optional<std::string> lastKey() const
+	{
+		return m_scopes.empty() ? std::nullopt : m_scopes.back().lastKey;
+	}
+
+private:
+	struct Scope
+	{
+		bool isObject = false;
+		bool empty = true;
+		std::optional<std::string> lastKey;
+	};
+
+	/// Checks that a value is expected and @returns the separator needed before it.
+	/// Every piece is written at once and recorded only afterwards, so that the state stays
+	/// consistent with the output if writing fails.
+	std::string separator() const;
+	/// Records that a value was written.
+	void valueWritten();
+
+	std::ostream& m_output;
+	std::vector<Scope> m_scopes;
+	bool m_keyWritten = false;
+	bool m_started = false;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
@@ -67,6 +136,23 @@ std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format);
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseStrict(std::string const& _input, Json::Value& _json, std::string* _errs = nullptr);
 
+/// Serialise the JSON object (@a _input) into a compact binary format. Every distinct string
+/// and member name is stored only once, integers are variable-length encoded and the
+/// distinction between signed and unsigned integers is kept, so that parsing the result with
+/// jsonBinaryParse yields a value that is printed exactly like @a _input.
+std::string jsonBinaryPrint(Json::Value const& _input);
+
+/// @returns true if @a _input starts with the header written by jsonBinaryPrint.
+/// Since such documents start with a zero byte, they cannot be confused with JSON text.
+bool isJsonBinary(std::string_view _input);
+
+/// Parse a document (@a _input) created by jsonBinaryPrint and writes resulting JSON object to (@a _json)
+/// \param _input binary input
+/// \param _json [out] resulting JSON object
+/// \param _errs [out] Formatted error messages
+/// \return \c true if the document was successfully parsed, \c false if an error occurred.
+bool jsonBinaryParse(std::string_view _input, Json::Value& _json, std::string* _errs = nullptr);
+
 namespace detail
 {
 
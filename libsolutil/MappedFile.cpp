@@ -0,0 +1,52 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/MappedFile.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+using namespace std;
+using namespace solidity::util;
+
+struct MappedFile::Mapping
+{
+	boost::interprocess::file_mapping file;
+	/// Empty for an empty file, which cannot be mapped.
+	boost::interprocess::mapped_region region;
+};
+
+MappedFile::MappedFile(boost::filesystem::path const& _path)
+{
+	assertThrow(boost::filesystem::exists(_path), FileNotFound, _path.string());
+	assertThrow(boost::filesystem::is_regular_file(_path), NotAFile, _path.string());
+
+	m_mapping = make_unique<Mapping>();
+	m_mapping->file = boost::interprocess::file_mapping(_path.string().c_str(), boost::interprocess::read_only);
+	if (boost::filesystem::file_size(_path) > 0)
+	{
+		m_mapping->region = boost::interprocess::mapped_region(m_mapping->file, boost::interprocess::read_only);
+		m_contents = {static_cast<char const*>(m_mapping->region.get_address()), m_mapping->region.get_size()};
+	}
+}
+
+MappedFile::~MappedFile() = default;
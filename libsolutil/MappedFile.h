@@ -0,0 +1,57 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Read-only memory mapping of a file.
+ */
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+
+#include <memory>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/**
+ * A whole file mapped read-only into memory, so that its contents can be used without
+ * reading them into a buffer first. The file must not be modified while it is mapped.
+ */
+class MappedFile
+{
+public:
+	/// Maps the file at @a _path.
+	/// Throws FileNotFound or NotAFile, like readFileAsString, if it is not a regular file.
+	explicit MappedFile(boost::filesystem::path const& _path);
+	~MappedFile();
+
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+
+	std::string_view contents() const noexcept { return m_contents; }
+
+private:
+	/// The boost::interprocess objects, which are only included by the implementation.
+	struct Mapping;
+
+	std::unique_ptr<Mapping> m_mapping;
+	std::string_view m_contents;
+};
+
+}
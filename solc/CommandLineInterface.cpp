@@ -46,6 +46,7 @@
 #include <libevmasm/Instruction.h>
 #include <libevmasm/Disassemble.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/HexLinker.h>
 
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceReferenceFormatter.h>
@@ -65,7 +66,6 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
-#include <boost/algorithm/string.hpp>
 
 #ifdef _WIN32 // windows
 	#include <io.h>
@@ -167,6 +167,31 @@ static bool coloredOutput(CommandLineOptions const& _options)
 		(_options.formatting.coloredOutput.has_value() && _options.formatting.coloredOutput.value());
 }
 
+/// @returns <source>:<line>:<column> of the start of @a _location.
+static string sourcePosition(CompilerStack const& _compiler, SourceLocation const& _location)
+{
+	if (!_location.sourceName)
+		return "<unknown>";
+	LineColumn start = _compiler.charStream(*_location.sourceName).translatePositionToLineColumn(_location.start);
+	return *_location.sourceName + ":" + to_string(start.line + 1) + ":" + to_string(start.column + 1);
+}
+
+void CommandLineInterface::handleModelCheckerStatistics()
+{
+	serr() << "SMTChecker statistics:" << endl;
+	for (auto const& target: m_compiler->modelCheckerTargetStatistics())
+		serr() << "  " << target.toString(sourcePosition(*m_compiler, target.location)) << endl;
+	for (auto const& [engine, solvers]: m_compiler->modelCheckerSolverStatistics())
+		for (auto const& [solver, statistics]: solvers)
+		{
+			serr() << "  " << engine << " " << solver << ": " << statistics.queries << " queries, " << statistics.answers << " answers, ";
+			serr() << chrono::duration_cast<chrono::milliseconds>(statistics.time).count() << " ms";
+			if (statistics.queryBytes > 0)
+				serr() << ", " << statistics.queryBytes << " bytes";
+			serr() << ", " << statistics.assertedNodes << " asserted nodes" << endl;
+		}
+}
+
 void CommandLineInterface::handleBinary(string const& _contract)
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
@@ -504,15 +529,14 @@ void CommandLineInterface::readInputFiles()
 		}
 
 		// NOTE: we ignore the FileNotFound exception as we manually check above
-		string fileContent = readFileAsString(infile);
 		if (m_options.input.mode == InputMode::StandardJson)
 		{
 			solAssert(!m_standardJsonInput.has_value());
-			m_standardJsonInput = std::move(fileContent);
+			m_standardJsonInput = readFileAsString(infile);
 		}
 		else
 		{
-			m_fileReader.addOrUpdateFile(infile, std::move(fileContent));
+			m_fileReader.mapFile(infile);
 			m_fileReader.allowDirectory(boost::filesystem::canonical(infile).remove_filename());
 		}
 	}
@@ -530,7 +554,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
-		m_fileReader.sourceUnits().empty() &&
+		m_fileReader.sourceStreams().empty() &&
 		!m_standardJsonInput.has_value()
 	)
 		solThrow(CommandLineValidationError, "All specified input files either do not exist or are not regular files.");
@@ -546,7 +570,10 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 	for (SourceCode const& sourceCode: m_fileReader.sourceUnits() | ranges::views::values)
 	{
 		Json::Value ast;
-		astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
+		if (isJsonBinary(sourceCode))
+			astAssert(jsonBinaryParse(sourceCode, ast), "Input file could not be parsed as binary AST");
+		else
+			astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
 		astAssert(ast.isMember("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
 
 		for (auto& src: ast["sources"].getMemberNames())
@@ -566,7 +593,7 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 	return sourceJsons;
 }
 
-void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+void CommandLineInterface::createFile(string const& _fileName, string const& _data, bool _binary)
 {
 	namespace fs = boost::filesystem;
 
@@ -581,7 +608,7 @@ void CommandLineInterface::createFile(string const& _fileName, string const& _da
 	if (fs::exists(pathName) && !m_options.output.overwriteFiles)
 		solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
 
-	ofstream outFile(pathName);
+	ofstream outFile(pathName, _binary ? ios::out | ios::binary : ios::out);
 	outFile << _data;
 	if (!outFile)
 		solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
@@ -653,7 +680,8 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
-		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << endl;
+		compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << endl;
 		m_standardJsonInput.reset();
 		break;
 	}
@@ -703,6 +731,10 @@ void CommandLineInterface::compile()
 		m_compiler->setMetadataHash(m_options.metadata.hash);
 		if (m_options.modelChecker.initialize)
 			m_compiler->setModelCheckerSettings(m_options.modelChecker.settings);
+		if (m_options.modelChecker.progress)
+			m_compiler->setModelCheckerProgressCallback([this](ModelCheckerTargetStatistics const& _target) {
+				serr() << "SMTChecker: " << _target.toString(sourcePosition(*m_compiler, _target.location)) << endl;
+			});
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
@@ -759,8 +791,9 @@ void CommandLineInterface::compile()
 		}
 		else
 		{
-			m_compiler->setSources(m_fileReader.sourceUnits());
+			m_compiler->setSources(m_fileReader.sourceStreams());
 			m_compiler->setParserErrorRecovery(m_options.input.errorRecovery);
+			m_compiler->setParserThreads(m_options.input.parserThreads);
 		}
 
 		bool successful = m_compiler->compile(m_options.output.stopAfter);
@@ -771,6 +804,9 @@ void CommandLineInterface::compile()
 			formatter.printErrorInformation(*error);
 		}
 
+		if (m_options.modelChecker.settings.statistics)
+			handleModelCheckerStatistics();
+
 		if (!successful && !m_options.input.errorRecovery)
 			solThrow(CommandLineExecutionError, "");
 	}
@@ -876,7 +912,7 @@ void CommandLineInterface::handleCombinedJSON()
 	if (m_options.compiler.combinedJsonRequests->ast)
 	{
 		output[g_strSources] = Json::Value(Json::objectValue);
-		for (auto const& sourceCode: m_fileReader.sourceUnits())
+		for (auto const& sourceCode: m_fileReader.sourceStreams())
 		{
 			ASTJsonExporter converter(m_compiler->state(), m_compiler->sourceIndices());
 			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
@@ -895,16 +931,31 @@ void CommandLineInterface::handleAst()
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
 
+	if (m_options.compiler.outputs.astBinary)
+	{
+		solAssert(!m_options.output.dir.empty());
+		for (auto const& sourceCode: m_fileReader.sourceStreams())
+		{
+			// Wrapped the same way as the sources in the standard JSON output and its astBinary
+			// member, so that the file can be passed to --import-ast directly.
+			Json::Value output(Json::objectValue);
+			output["sources"][sourceCode.first]["ast"] =
+				ASTJsonExporter(m_compiler->state(), m_compiler->sourceIndices()).toJson(m_compiler->ast(sourceCode.first));
+			boost::filesystem::path path(sourceCode.first);
+			createFile(path.filename().string() + "_binary.ast", jsonBinaryPrint(output), true);
+		}
+	}
+
 	if (!m_options.compiler.outputs.astCompactJson)
 		return;
 
 	vector<ASTNode const*> asts;
-	for (auto const& sourceCode: m_fileReader.sourceUnits())
+	for (auto const& sourceCode: m_fileReader.sourceStreams())
 		asts.push_back(&m_compiler->ast(sourceCode.first));
 
 	if (!m_options.output.dir.empty())
 	{
-		for (auto const& sourceCode: m_fileReader.sourceUnits())
+		for (auto const& sourceCode: m_fileReader.sourceStreams())
 		{
 			stringstream data;
 			string postfix = "";
@@ -917,7 +968,7 @@ void CommandLineInterface::handleAst()
 	else
 	{
 		sout() << "JSON AST (compact format):" << endl << endl;
-		for (auto const& sourceCode: m_fileReader.sourceUnits())
+		for (auto const& sourceCode: m_fileReader.sourceStreams())
 		{
 			sout() << endl << "======= " << sourceCode.first << " =======" << endl;
 			ASTJsonExporter(m_compiler->state(), m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceCode.first), m_options.formatting.json);
@@ -936,61 +987,35 @@ void CommandLineInterface::link()
 {
 	solAssert(m_options.input.mode == InputMode::Linker);
 
-	// Map from how the libraries will be named inside the bytecode to their addresses.
-	map<string, h160> librariesReplacements;
-	int const placeholderSize = 40; // 20 bytes or 40 hex characters
-	for (auto const& library: m_options.linker.libraries)
-	{
-		string const& name = library.first;
-		// Library placeholders are 40 hex digits (20 bytes) that start and end with '__'.
-		// This leaves 36 characters for the library identifier. The identifier used to
-		// be just the cropped or '_'-padded library name, but this changed to
-		// the cropped hex representation of the hash of the library name.
-		// We support both ways of linking here.
-		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = library.second;
-
-		string replacement = "__";
-		for (size_t i = 0; i < placeholderSize - 4; ++i)
-			replacement.push_back(i < name.size() ? name[i] : '_');
-		replacement += "__";
-		librariesReplacements[replacement] = library.second;
-	}
+	// Everything that depends only on the libraries is computed once here
+	// and not again for every input file.
+	evmasm::HexLinker const linker(m_options.linker.libraries);
 
+	m_unresolvedReferences = Json::objectValue;
 	FileReader::StringMap sourceCodes = m_fileReader.sourceUnits();
-	for (auto& src: sourceCodes)
+	for (auto& [name, code]: sourceCodes)
 	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		vector<evmasm::HexLinker::UnresolvedReference> unresolved;
+		try
 		{
-			while (it != end && *it != '_') ++it;
-			if (it == end) break;
-			if (
-				end - it < placeholderSize ||
-				*(it + 1) != '_' ||
-				*(it + placeholderSize - 2) != '_' ||
-				*(it + placeholderSize - 1) != '_'
-			)
-				solThrow(
-					CommandLineExecutionError,
-					"Error in binary object file " + src.first + " at position " + to_string(it - src.second.begin()) + "\n" +
-					'"' + string(it, it + min(placeholderSize, static_cast<int>(end - it))) + "\" is not a valid link reference."
-				);
-
-			string foundPlaceholder(it, it + placeholderSize);
-			if (librariesReplacements.count(foundPlaceholder))
+			unresolved = linker.link(code);
+		}
+		catch (evmasm::InvalidLinkReference const& _exception)
+		{
+			solAssert(_exception.comment());
+			solThrow(CommandLineExecutionError, "Error in binary object file " + name + " " + *_exception.comment());
+		}
+
+		for (auto const& reference: unresolved)
+			if (m_options.linker.summary)
 			{
-				string hexStr(util::toHex(librariesReplacements.at(foundPlaceholder).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
+				Json::Value entry = Json::objectValue;
+				entry["reference"] = reference.placeholder;
+				entry["position"] = Json::UInt64(reference.position);
+				m_unresolvedReferences[name].append(std::move(entry));
 			}
 			else
-				serr() << "Reference \"" << foundPlaceholder << "\" in file \"" << src.first << "\" still unresolved." << endl;
-			it += placeholderSize;
-		}
-		// Remove hints for resolved libraries.
-		for (auto const& library: m_options.linker.libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+				serr() << "Reference \"" << reference.placeholder << "\" in file \"" << name << "\" still unresolved." << endl;
 	}
 	m_fileReader.setSourceUnits(std::move(sourceCodes));
 }
@@ -1009,12 +1034,15 @@ void CommandLineInterface::writeLinkedFiles()
 			if (!outFile)
 				solThrow(CommandLineOutputError, "Could not write to file " + src.first + ". Aborting.");
 		}
-	sout() << "Linking completed." << endl;
-}
-
-string CommandLineInterface::libraryPlaceholderHint(string const& _libraryName)
-{
-	return "// " + evmasm::LinkerObject::libraryPlaceholder(_libraryName) + " -> " + _libraryName;
+	if (m_options.linker.summary)
+	{
+		Json::Value summary = Json::objectValue;
+		summary["linkedFiles"] = Json::UInt64(m_fileReader.sourceUnits().size());
+		summary["unresolvedReferences"] = m_unresolvedReferences;
+		sout() << util::jsonPrint(summary, m_options.formatting.json) << endl;
+	}
+	else
+		sout() << "Linking completed." << endl;
 }
 
 string CommandLineInterface::objectWithLinkRefsHex(evmasm::LinkerObject const& _obj)
@@ -1024,7 +1052,7 @@ string CommandLineInterface::objectWithLinkRefsHex(evmasm::LinkerObject const& _
 	{
 		out += "\n";
 		for (auto const& linkRef: _obj.linkReferences)
-			out += "\n" + libraryPlaceholderHint(linkRef.second);
+			out += "\n" + evmasm::HexLinker::libraryPlaceholderHint(linkRef.second);
 	}
 	return out;
 }
@@ -1137,6 +1165,8 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 void CommandLineInterface::outputCompilationResults()
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+	// The AST output uses the types of the compilation.
+	auto typeProviderScope = m_compiler->typeProviderScope();
 
 	handleCombinedJSON();
 
@@ -1144,8 +1174,8 @@ void CommandLineInterface::outputCompilationResults()
 	handleAst();
 
 	if (
-		!m_compiler->compilationSuccessful() &&
-		m_options.output.stopAfter == CompilerStack::State::CompilationSuccessful
+		m_options.output.stopAfter >= CompilerStack::State::AnalysisPerformed &&
+		(m_compiler->hasError() || m_compiler->state() < m_options.output.stopAfter)
 	)
 	{
 		serr() << endl << "Compilation halted after AST generation due to errors." << endl;
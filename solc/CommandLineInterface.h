@@ -87,8 +87,6 @@ private:
 	void serveLSP();
 	void link();
 	void writeLinkedFiles();
-	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
-	static std::string libraryPlaceholderHint(std::string const& _libraryName);
 	/// @returns the full object with library placeholder hints in hex.
 	static std::string objectWithLinkRefsHex(evmasm::LinkerObject const& _obj);
 
@@ -110,17 +108,20 @@ private:
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
 	void handleStorageLayout(std::string const& _contract);
+	/// Prints the outcome of every target checked by the model checker and the counters of its solvers.
+	void handleModelCheckerStatistics();
 
 	/// Tries to read @ m_sourceCodes as a JSONs holding ASTs
 	/// such that they can be imported into the compiler  (importASTs())
 	/// (produced by --combined-json ast <file.sol>
-	/// or standard-json output
+	/// or standard-json output) or binary ASTs (produced by --ast-binary)
 	std::map<std::string, Json::Value> parseAstFromInput();
 
 	/// Create a file in the given directory
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
-	void createFile(std::string const& _fileName, std::string const& _data);
+	/// @arg _binary whether @a _data must be written without newline translation
+	void createFile(std::string const& _fileName, std::string const& _data, bool _binary = false);
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
@@ -144,6 +145,8 @@ private:
 	UniversalCallback m_universalCallback{m_fileReader, m_solverCommand};
 	std::optional<std::string> m_standardJsonInput;
 	std::unique_ptr<frontend::CompilerStack> m_compiler;
+	/// Link references that could not be resolved, per input file. Only filled in with --link-summary.
+	Json::Value m_unresolvedReferences;
 	CommandLineOptions m_options;
 };
 
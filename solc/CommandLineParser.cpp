@@ -61,19 +61,27 @@ static string const g_strIPFS = "ipfs";
 static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
 static string const g_strLink = "link";
+static string const g_strLinkSummary = "link-summary";
 static string const g_strLSP = "lsp";
 static string const g_strMachine = "machine";
 static string const g_strNoCBORMetadata = "no-cbor-metadata";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerCache = "model-checker-cache";
 static string const g_strModelCheckerContracts = "model-checker-contracts";
 static string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static string const g_strModelCheckerEngine = "model-checker-engine";
 static string const g_strModelCheckerExtCalls = "model-checker-ext-calls";
+static string const g_strModelCheckerIncremental = "model-checker-incremental";
 static string const g_strModelCheckerInvariants = "model-checker-invariants";
+static string const g_strModelCheckerPortfolio = "model-checker-portfolio";
+static string const g_strModelCheckerProgress = "model-checker-progress";
 static string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
+static string const g_strModelCheckerSliceQueries = "model-checker-slice-queries";
 static string const g_strModelCheckerSolvers = "model-checker-solvers";
+static string const g_strModelCheckerStatistics = "model-checker-statistics";
 static string const g_strModelCheckerTargets = "model-checker-targets";
+static string const g_strModelCheckerThreads = "model-checker-threads";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
 static string const g_strNone = "none";
 static string const g_strNoOptimizeYul = "no-optimize-yul";
@@ -83,9 +91,11 @@ static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strYulOptimizations = "yul-optimizations";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
+static string const g_strParserThreads = "parser-threads";
 static string const g_strRevertStrings = "revert-strings";
 static string const g_strStopAfter = "stop-after";
 static string const g_strParsing = "parsing";
+static string const g_strAnalysis = "analysis";
 
 /// Possible arguments to for --revert-strings
 static set<string> const g_revertStringsArgs
@@ -226,6 +236,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		input.allowedDirectories == _other.input.allowedDirectories &&
 		input.ignoreMissingFiles == _other.input.ignoreMissingFiles &&
 		input.errorRecovery == _other.input.errorRecovery &&
+		input.parserThreads == _other.input.parserThreads &&
 		output.dir == _other.output.dir &&
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
@@ -238,6 +249,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		assembly.targetMachine == _other.assembly.targetMachine &&
 		assembly.inputLanguage == _other.assembly.inputLanguage &&
 		linker.libraries == _other.linker.libraries &&
+		linker.summary == _other.linker.summary &&
 		formatting.json == _other.formatting.json &&
 		formatting.coloredOutput == _other.formatting.coloredOutput &&
 		formatting.withErrorIds == _other.formatting.withErrorIds &&
@@ -252,7 +264,8 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.noOptimizeYul == _other.optimizer.noOptimizeYul &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
-		modelChecker.settings == _other.modelChecker.settings;
+		modelChecker.settings == _other.modelChecker.settings &&
+		modelChecker.progress == _other.modelChecker.progress;
 }
 
 OptimiserSettings CommandLineOptions::optimiserSettings() const
@@ -513,6 +526,12 @@ void CommandLineParser::parseOutputSelection()
 			joinOptionNames(unsupportedOutputs) + "."
 		);
 
+	if (m_options.compiler.outputs.astBinary && m_options.output.dir.empty())
+		solThrow(
+			CommandLineValidationError,
+			"Option --" + CompilerOutputs::componentName(&CompilerOutputs::astBinary) + " requires --" + g_strOutputDir + "."
+		);
+
 	// TODO: restrict EOF version to correct EVM version.
 }
 
@@ -573,6 +592,12 @@ General Information)").c_str(),
 			g_strErrorRecovery.c_str(),
 			"Enables additional parser error recovery."
 		)
+		(
+			g_strParserThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Set the number of threads used to parse the input files and the files they import. "
+			"The resulting AST does not depend on the number of threads."
+		)
 	;
 	desc.add(inputOptions);
 
@@ -628,7 +653,8 @@ General Information)").c_str(),
 		(
 			g_strStopAfter.c_str(),
 			po::value<string>()->value_name("stage"),
-			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
+			"Stop execution after the given compiler stage. Valid options: \"parsing\", \"analysis\". "
+			"With \"analysis\" all errors and warnings are reported, but no code is generated."
 		)
 	;
 	desc.add(outputOptions);
@@ -642,7 +668,7 @@ General Information)").c_str(),
 		)
 		(
 			g_strLink.c_str(),
-			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " "
+			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " and --" + g_strLinkSummary + ", "
 			"and modify binaries in place.").c_str()
 		)
 		(
@@ -701,6 +727,11 @@ General Information)").c_str(),
 			"<libraryName>=<address> [, or whitespace] ...\n"
 			"Address is interpreted as a hex string prefixed by 0x."
 		)
+		(
+			g_strLinkSummary.c_str(),
+			"Instead of a message for every link reference that could not be resolved, "
+			"print a JSON summary of the number of linked files and of the unresolved references in each of them."
+		)
 	;
 	desc.add(linkerModeOptions);
 
@@ -733,6 +764,11 @@ General Information)").c_str(),
 	po::options_description outputComponents("Output Components");
 	outputComponents.add_options()
 		(CompilerOutputs::componentName(&CompilerOutputs::astCompactJson).c_str(), "AST of all source files in a compact JSON format.")
+		(
+			CompilerOutputs::componentName(&CompilerOutputs::astBinary).c_str(),
+			"AST of all source files in a compact binary encoding of the JSON AST, which --import-ast accepts. "
+			"Requires --output-dir."
+		)
 		(CompilerOutputs::componentName(&CompilerOutputs::asm_).c_str(), "EVM assembly of the contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::asmJson).c_str(), "EVM assembly of the contracts in JSON format.")
 		(CompilerOutputs::componentName(&CompilerOutputs::opcodes).c_str(), "Opcodes of the contracts.")
@@ -815,6 +851,12 @@ General Information)").c_str(),
 
 	po::options_description smtCheckerOptions("Model Checker Options");
 	smtCheckerOptions.add_options()
+		(
+			g_strModelCheckerCache.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the answers of the solvers in the given directory and reuse them in later runs. "
+			"Only definitive answers are stored, keyed by the query and the solver, including its version."
+		)
 		(
 			g_strModelCheckerContracts.c_str(),
 			po::value<string>()->value_name("default,<source>:<contract>")->default_value("default"),
@@ -838,6 +880,12 @@ General Information)").c_str(),
 			"Select whether to assume (trusted) that external calls always invoke"
 			" the code given by the type of the contract, if that code is available."
 		)
+		(
+			g_strModelCheckerIncremental.c_str(),
+			"Make BMC assert the constraints shared by the queries of a contract and of a function "
+			"in the solver once, and check each query in its own push/pop scope. "
+			"Only used with the solvers linked into the compiler (z3, cvc4)."
+		)
 		(
 			g_strModelCheckerInvariants.c_str(),
 			po::value<string>()->value_name("default,all,contract,reentrancy")->default_value("default"),
@@ -845,15 +893,38 @@ General Information)").c_str(),
 			" Multiple types of invariants can be selected at the same time, separated by a comma and no spaces."
 			" By default no invariants are reported."
 		)
+		(
+			g_strModelCheckerPortfolio.c_str(),
+			po::value<string>()->value_name("sequential,race,parallel")->default_value("sequential"),
+			"Select how BMC queries the solvers if more than one is selected. "
+			"\"sequential\" queries them one after the other and cross-checks their answers, "
+			"\"race\" queries them concurrently and takes the first definitive answer, "
+			"\"parallel\" queries them concurrently and cross-checks their answers."
+		)
+		(
+			g_strModelCheckerProgress.c_str(),
+			"Print a line to stderr whenever a verification target has been checked, "
+			"with its result, the solver that answered and the time it took."
+		)
 		(
 			g_strModelCheckerShowUnproved.c_str(),
 			"Show all unproved targets separately."
 		)
+		(
+			g_strModelCheckerSliceQueries.c_str(),
+			"Make BMC first check only the constraints that share variables with a verification target "
+			"and its path condition, and the whole query only if these constraints are satisfiable."
+		)
 		(
 			g_strModelCheckerSolvers.c_str(),
 			po::value<string>()->value_name("cvc4,eld,z3,smtlib2")->default_value("z3"),
 			"Select model checker solvers."
 		)
+		(
+			g_strModelCheckerStatistics.c_str(),
+			"Print the result, solver, query size and time of every verification target "
+			"and the counters of each solver after the compilation."
+		)
 		(
 			g_strModelCheckerTargets.c_str(),
 			po::value<string>()->value_name("default,all,constantCondition,underflow,overflow,divByZero,balance,assert,popEmptyArray,outOfBounds")->default_value("default"),
@@ -861,6 +932,13 @@ General Information)").c_str(),
 			"Multiple targets can be selected at the same time, separated by a comma and no spaces."
 			" By default all targets except underflow and overflow are selected."
 		)
+		(
+			g_strModelCheckerThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Set the number of threads BMC uses to solve the queries of a function in parallel, "
+			"and CHC the queries of a source unit. "
+			"Queries are only solved in parallel by the solvers linked into the compiler."
+		)
 		(
 			g_strModelCheckerTimeout.c_str(),
 			po::value<unsigned>()->value_name("ms"),
@@ -948,19 +1026,28 @@ void CommandLineParser::processArgs()
 	map<string, set<InputMode>> validOptionInputModeCombinations = {
 		// TODO: This should eventually contain all options.
 		{g_strErrorRecovery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strLinkSummary, {InputMode::Linker}},
+		{g_strParserThreads, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnproved, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerSliceQueries, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerDivModNoSlacks, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerEngine, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerIncremental, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerInvariants, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerPortfolio, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerProgress, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerStatistics, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
-		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
+		{g_strModelCheckerCache, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerThreads, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
 	};
 	vector<string> invalidOptionsForCurrentInputMode;
 	for (auto const& [optionName, inputModes]: validOptionInputModeCombinations)
@@ -1109,10 +1196,16 @@ void CommandLineParser::processArgs()
 
 	if (m_args.count(g_strStopAfter))
 	{
-		if (m_args[g_strStopAfter].as<string>() != "parsing")
-			solThrow(CommandLineValidationError, "Valid options for --" + g_strStopAfter + " are: \"parsing\".\n");
-		else
+		string const stopAfter = m_args[g_strStopAfter].as<string>();
+		if (stopAfter == g_strParsing)
 			m_options.output.stopAfter = CompilerStack::State::Parsed;
+		else if (stopAfter == g_strAnalysis)
+			m_options.output.stopAfter = CompilerStack::State::AnalysisPerformed;
+		else
+			solThrow(
+				CommandLineValidationError,
+				"Valid options for --" + g_strStopAfter + " are: \"" + g_strParsing + "\", \"" + g_strAnalysis + "\".\n"
+			);
 	}
 
 	parseInputPathsAndRemappings();
@@ -1125,7 +1218,10 @@ void CommandLineParser::processArgs()
 			parseLibraryOption(library);
 
 	if (m_options.input.mode == InputMode::Linker)
+	{
+		m_options.linker.summary = m_args.count(g_strLinkSummary) > 0;
 		return;
+	}
 
 	if (m_args.count(g_strEVMVersion))
 	{
@@ -1275,6 +1371,16 @@ void CommandLineParser::processArgs()
 		m_options.metadata.format = CompilerStack::MetadataFormat::NoMetadata;
 	}
 
+	if (m_args.count(g_strModelCheckerCache))
+	{
+		boost::filesystem::path cacheDirectory = m_args[g_strModelCheckerCache].as<string>();
+		if (cacheDirectory.empty())
+			solThrow(CommandLineValidationError, "Empty path given for --" + g_strModelCheckerCache + ".");
+		if (boost::filesystem::exists(cacheDirectory) && !boost::filesystem::is_directory(cacheDirectory))
+			solThrow(CommandLineValidationError, "--" + g_strModelCheckerCache + " must be a directory: " + cacheDirectory.string());
+		m_options.modelChecker.settings.cacheDirectory = std::move(cacheDirectory);
+	}
+
 	if (m_args.count(g_strModelCheckerContracts))
 	{
 		string contractsStr = m_args[g_strModelCheckerContracts].as<string>();
@@ -1305,6 +1411,9 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.externalCalls = *extCallsMode;
 	}
 
+	if (m_args.count(g_strModelCheckerIncremental))
+		m_options.modelChecker.settings.incremental = true;
+
 	if (m_args.count(g_strModelCheckerInvariants))
 	{
 		string invsStr = m_args[g_strModelCheckerInvariants].as<string>();
@@ -1317,6 +1426,21 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerShowUnproved))
 		m_options.modelChecker.settings.showUnproved = true;
 
+	if (m_args.count(g_strModelCheckerSliceQueries))
+		m_options.modelChecker.settings.sliceQueries = true;
+
+	if (m_args.count(g_strModelCheckerPortfolio))
+	{
+		string mode = m_args[g_strModelCheckerPortfolio].as<string>();
+		optional<ModelCheckerPortfolio> portfolio = ModelCheckerPortfolio::fromString(mode);
+		if (!portfolio)
+			solThrow(CommandLineValidationError, "Invalid option for --" + g_strModelCheckerPortfolio + ": " + mode);
+		m_options.modelChecker.settings.portfolio = *portfolio;
+	}
+
+	if (m_args.count(g_strModelCheckerProgress))
+		m_options.modelChecker.progress = true;
+
 	if (m_args.count(g_strModelCheckerSolvers))
 	{
 		string solversStr = m_args[g_strModelCheckerSolvers].as<string>();
@@ -1326,6 +1450,9 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.solvers = *solvers;
 	}
 
+	if (m_args.count(g_strModelCheckerStatistics))
+		m_options.modelChecker.settings.statistics = true;
+
 	if (m_args.count(g_strModelCheckerTargets))
 	{
 		string targetsStr = m_args[g_strModelCheckerTargets].as<string>();
@@ -1335,24 +1462,46 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.targets = *targets;
 	}
 
+	if (m_args.count(g_strModelCheckerThreads))
+	{
+		unsigned threads = m_args[g_strModelCheckerThreads].as<unsigned>();
+		if (threads == 0)
+			solThrow(CommandLineValidationError, "Invalid option for --" + g_strModelCheckerThreads + ": 0");
+		m_options.modelChecker.settings.threads = threads;
+	}
+
 	if (m_args.count(g_strModelCheckerTimeout))
 		m_options.modelChecker.settings.timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
 
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
+		m_args.count(g_strModelCheckerCache) ||
 		m_args.count(g_strModelCheckerContracts) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerExtCalls) ||
+		m_args.count(g_strModelCheckerIncremental) ||
 		m_args.count(g_strModelCheckerInvariants) ||
+		m_args.count(g_strModelCheckerPortfolio) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
+		m_args.count(g_strModelCheckerSliceQueries) ||
 		m_args.count(g_strModelCheckerSolvers) ||
+		m_args.count(g_strModelCheckerStatistics) ||
 		m_args.count(g_strModelCheckerTargets) ||
+		m_args.count(g_strModelCheckerThreads) ||
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 	if (m_options.input.mode == InputMode::Compiler)
 		m_options.input.errorRecovery = (m_args.count(g_strErrorRecovery) > 0);
 
+	if (m_options.input.mode == InputMode::Compiler && m_args.count(g_strParserThreads))
+	{
+		unsigned threads = m_args[g_strParserThreads].as<unsigned>();
+		if (threads == 0)
+			solThrow(CommandLineValidationError, "Invalid option for --" + g_strParserThreads + ": 0");
+		m_options.input.parserThreads = threads;
+	}
+
 	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport);
 }
 
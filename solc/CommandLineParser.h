@@ -70,6 +70,7 @@ struct CompilerOutputs
 	{
 		static std::map<std::string, bool CompilerOutputs::*> const components = {
 			{"ast-compact-json", &CompilerOutputs::astCompactJson},
+			{"ast-binary", &CompilerOutputs::astBinary},
 			{"asm", &CompilerOutputs::asm_},
 			{"asm-json", &CompilerOutputs::asmJson},
 			{"opcodes", &CompilerOutputs::opcodes},
@@ -105,6 +106,7 @@ struct CompilerOutputs
 	bool natspecDev = false;
 	bool metadata = false;
 	bool storageLayout = false;
+	bool astBinary = false;
 };
 
 struct CombinedJsonRequests
@@ -175,6 +177,7 @@ struct CommandLineOptions
 		FileReader::FileSystemPathSet allowedDirectories;
 		bool ignoreMissingFiles = false;
 		bool errorRecovery = false;
+		unsigned parserThreads = 1;
 	} input;
 
 	struct
@@ -198,6 +201,7 @@ struct CommandLineOptions
 	struct
 	{
 		std::map<std::string, util::h160> libraries; // library name -> address
+		bool summary = false; ///< Whether unresolved references are reported in a JSON summary.
 	} linker;
 
 	struct
@@ -233,6 +237,8 @@ struct CommandLineOptions
 	{
 		bool initialize = false;
 		ModelCheckerSettings settings;
+		/// Whether a line is printed to stderr whenever a verification target has been checked.
+		bool progress = false;
 	} modelChecker;
 };
 
@@ -0,0 +1,85 @@
+#!/usr/bin/env bash
+
+#------------------------------------------------------------------------------
+# Bash script comparing the time solc needs to report errors and warnings with
+# --stop-after analysis to the time of a full compilation.
+# ------------------------------------------------------------------------------
+# This file is part of solidity.
+#
+# solidity is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# solidity is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with solidity.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2023 solidity contributors.
+#------------------------------------------------------------------------------
+
+set -euo pipefail
+
+REPO_ROOT=$(cd "$(dirname "$0")/../../" && pwd)
+SOLIDITY_BUILD_DIR=${SOLIDITY_BUILD_DIR:-${REPO_ROOT}/build}
+# Directory whose single-source test files are compiled one after another as the corpus.
+CORPUS_DIR=${CORPUS_DIR:-${REPO_ROOT}/test/libsolidity/semanticTests}
+
+output_dir=$(mktemp -d -t solc-benchmark-XXXXXX)
+result_file="${output_dir}/benchmark.txt"
+corpus_file="${output_dir}/corpus.txt"
+
+function cleanup() {
+    rm -r "${output_dir}"
+    exit
+}
+
+trap cleanup SIGINT SIGTERM
+
+solc="${SOLIDITY_BUILD_DIR}/solc/solc"
+benchmarks_dir="${REPO_ROOT}/test/benchmarks"
+benchmarks=("chains.sol" "OptimizorClub.sol" "verifier.sol")
+time_bin_path=$(type -P time)
+
+# Prints the wall clock time of the given command. Errors of the compiler are expected
+# in the corpus and reported the same way in both modes, so the exit code is ignored.
+function measure() {
+    "${time_bin_path}" --output "${result_file}" --format "%e" "$@" > /dev/null 2>&1 || true
+    # time prefixes the result with a note about the exit status if it is not zero.
+    tail --lines 1 "${result_file}"
+}
+
+function report() {
+    local name="$1"
+    local full="$2"
+    local analysis="$3"
+    local saving
+    saving=$(python3 -c "print(f'{100 * (1 - ${analysis} / max(${full}, 0.01)):.0f}')")
+    printf "%-24s %8s s %8s s %6s %%\n" "${name}" "${full}" "${analysis}" "${saving}"
+}
+
+# Tests consisting of several sources are not valid Solidity files on their own.
+{ grep --recursive --files-without-match --include '*.sol' '^==== \(Source\|ExternalSource\)' "${CORPUS_DIR}" || true; } | sort > "${corpus_file}"
+
+echo "======================================================="
+echo "     full compilation vs. --stop-after analysis"
+echo "-------------------------------------------------------"
+printf "%-24s %10s %10s %8s\n" "input" "full" "analysis" "saving"
+for input_file in "${benchmarks[@]}"
+do
+    input_path="${benchmarks_dir}/${input_file}"
+    full=$(measure "${solc}" --optimize "${input_path}")
+    analysis=$(measure "${solc}" --optimize --stop-after analysis "${input_path}")
+    report "${input_file}" "${full}" "${analysis}"
+done
+
+full=$(measure xargs --arg-file "${corpus_file}" --max-args 1 "${solc}" --optimize)
+analysis=$(measure xargs --arg-file "${corpus_file}" --max-args 1 "${solc}" --optimize --stop-after analysis)
+report "corpus ($(wc -l < "${corpus_file}") files)" "${full}" "${analysis}"
+echo "======================================================="
+
+cleanup
@@ -0,0 +1,87 @@
+#!/usr/bin/env bash
+
+#------------------------------------------------------------------------------
+# Bash script measuring the throughput of the scanner on large generated inputs
+# consisting mostly of one class of characters (comments, literals, identifiers).
+# ------------------------------------------------------------------------------
+# This file is part of solidity.
+#
+# solidity is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# solidity is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with solidity.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2023 solidity contributors.
+#------------------------------------------------------------------------------
+
+set -euo pipefail
+
+REPO_ROOT=$(cd "$(dirname "$0")/../../" && pwd)
+SOLIDITY_BUILD_DIR=${SOLIDITY_BUILD_DIR:-${REPO_ROOT}/build}
+# Approximate size of each generated input in megabytes.
+SIZE_MB=${SIZE_MB:-32}
+
+output_dir=$(mktemp -d -t solc-benchmark-XXXXXX)
+result_file="${output_dir}/benchmark.txt"
+
+function cleanup() {
+    rm -r "${output_dir}"
+    exit
+}
+
+trap cleanup SIGINT SIGTERM
+
+solc="${SOLIDITY_BUILD_DIR}/solc/solc"
+time_bin_path=$(type -P time)
+
+python3 - "$output_dir" "$SIZE_MB" <<'PYTHON'
+import random
+import sys
+from pathlib import Path
+
+output_dir = Path(sys.argv[1])
+size = int(sys.argv[2]) * 1024 * 1024
+random.seed(0)
+line = "lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor"
+hex_digits = "".join(random.choice("0123456789abcdef") for _ in range(64 * 1024))
+declaration = "    uint256 someRatherLongIdentifierNumber{0} = anotherRatherLongIdentifier{0} + yetAnotherIdentifier{0};\n"
+
+inputs = {
+    "multi_line_comment": "/*\n" + (line + "\n") * (size // (len(line) + 1)) + "*/\n",
+    "natspec_comment": "/**\n" + (" * " + line + "\n") * (size // (len(line) + 4)) + " */\ncontract C {}\n",
+    "single_line_comments": ("// " + line + "\n") * (size // (len(line) + 4)),
+    "hex_literals": "contract C {\n" + "".join(
+        f'    bytes constant h{i} = hex"{hex_digits}";\n' for i in range(size // len(hex_digits))
+    ) + "}\n",
+    "string_literals": "contract C {\n" + "".join(
+        f'    string constant s{i} = "{line * 800}";\n' for i in range(size // (len(line) * 800))
+    ) + "}\n",
+    "identifiers": "contract C {\n    function f() public {\n" + "".join(
+        declaration.format(i) for i in range(size // len(declaration.format(100000)))
+    ) + "    }\n}\n",
+}
+for name, content in inputs.items():
+    (output_dir / f"{name}.sol").write_text("// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\n" + content)
+PYTHON
+
+echo "======================================================="
+echo "     scanner throughput (solc --stop-after parsing)"
+echo "-------------------------------------------------------"
+for input_file in "${output_dir}"/*.sol; do
+    "${time_bin_path}" --output "${result_file}" --format "%e" "${solc}" --stop-after parsing "${input_file}" > /dev/null
+    read -r seconds < "${result_file}"
+    size_bytes=$(stat --format %s "${input_file}")
+    throughput=$(python3 -c "print(f'{${size_bytes} / 1024 / 1024 / max(${seconds}, 0.01):.1f}')")
+    printf "%-24s %8s s %10s MB/s\n" "$(basename "${input_file}" .sol)" "${seconds}" "${throughput}"
+done
+echo "======================================================="
+
+cleanup
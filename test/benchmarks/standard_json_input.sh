@@ -0,0 +1,75 @@
+#!/usr/bin/env bash
+
+#------------------------------------------------------------------------------
+# Bash script measuring time and memory used by solc --standard-json on a large input.
+# ------------------------------------------------------------------------------
+# This file is part of solidity.
+#
+# solidity is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# solidity is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with solidity.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2023 solidity contributors.
+#------------------------------------------------------------------------------
+
+set -euo pipefail
+
+REPO_ROOT=$(cd "$(dirname "$0")/../../" && pwd)
+SOLIDITY_BUILD_DIR=${SOLIDITY_BUILD_DIR:-${REPO_ROOT}/build}
+# Number of copies of each benchmark contract in the input.
+COPIES=${COPIES:-200}
+
+output_dir=$(mktemp -d -t solc-benchmark-XXXXXX)
+input_file="${output_dir}/input.json"
+result_file="${output_dir}/benchmark.txt"
+
+function cleanup() {
+    rm -r "${output_dir}"
+    exit
+}
+
+trap cleanup SIGINT SIGTERM
+
+solc="${SOLIDITY_BUILD_DIR}/solc/solc"
+benchmarks_dir="${REPO_ROOT}/test/benchmarks"
+time_bin_path=$(type -P time)
+
+python3 - "$benchmarks_dir" "$COPIES" > "$input_file" <<'PYTHON'
+import json
+import sys
+from pathlib import Path
+
+benchmarks_dir = Path(sys.argv[1])
+copies = int(sys.argv[2])
+sources = {}
+for path in sorted(benchmarks_dir.glob("*.sol")):
+    content = path.read_text(encoding="utf-8")
+    for i in range(copies):
+        sources[f"{i}/{path.name}"] = {"content": content}
+json.dump({
+    "language": "Solidity",
+    "sources": sources,
+    "settings": {"stopAfter": "parsing", "outputSelection": {"*": {"": ["ast"]}}},
+}, sys.stdout)
+PYTHON
+
+"${time_bin_path}" --output "${result_file}" --format "%e %M" "${solc}" --standard-json "${input_file}" > /dev/null
+read -r seconds max_rss_kib < "${result_file}"
+
+echo "======================================================="
+echo "     standard JSON input of $(du -h "${input_file}" | cut -f1)"
+echo "-------------------------------------------------------"
+echo "parsing and AST output took ${seconds} seconds to execute."
+echo "maximum resident set size was ${max_rss_kib} KiB."
+echo "======================================================="
+
+cleanup
@@ -29,6 +29,7 @@
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
@@ -1650,6 +1651,54 @@ BOOST_AUTO_TEST_CASE(cse_replace_too_large_shift)
 	});
 }
 
+BOOST_AUTO_TEST_CASE(cse_expression_classes_clear)
+{
+	ExpressionClasses classes;
+	ExpressionClasses::Id one = classes.find(AssemblyItem(u256(1)));
+	classes.find(Instruction::ADD, {one, classes.newClass({})});
+	BOOST_CHECK(classes.size() > 0);
+
+	classes.clear();
+	BOOST_CHECK_EQUAL(classes.size(), 0);
+	ExpressionClasses::Id seven = classes.find(AssemblyItem(u256(7)));
+	BOOST_CHECK_EQUAL(seven, 0);
+	u256 const* value = classes.knownConstant(seven);
+	BOOST_REQUIRE(value);
+	BOOST_CHECK_EQUAL(*value, 7);
+}
+
+BOOST_AUTO_TEST_CASE(constant_optimiser_shared_cache)
+{
+	Assembly::OptimiserSettings settings;
+	settings.runConstantOptimiser = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	auto optimiseConstants = [&](vector<u256> const& _constants) {
+		Assembly assembly{settings.evmVersion, false, {}};
+		for (u256 const& constant: _constants)
+		{
+			assembly.append(constant);
+			assembly.append(Instruction::POP);
+		}
+		assembly.optimise(settings);
+		return assembly.items();
+	};
+
+	ComputeMethod::clearCache();
+	vector<u256> constants{(u256(1) << 160) - 1};
+	AssemblyItems uncached = optimiseConstants(constants);
+	AssemblyItems cached = optimiseConstants(constants);
+	BOOST_CHECK_EQUAL_COLLECTIONS(uncached.begin(), uncached.end(), cached.begin(), cached.end());
+
+	// Push the first routine out of the cache by using more distinct constants than it can hold.
+	vector<u256> others;
+	for (size_t i = 0; i < 5000; ++i)
+		others.emplace_back(0x100 + i);
+	optimiseConstants(others);
+	AssemblyItems evicted = optimiseConstants(constants);
+	BOOST_CHECK_EQUAL_COLLECTIONS(uncached.begin(), uncached.end(), evicted.begin(), evicted.end());
+}
+
 BOOST_AUTO_TEST_CASE(inliner)
 {
 	AssemblyItem jumpInto{Instruction::JUMP};
@@ -0,0 +1,132 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the bulk character searches used by the scanner.
+ */
+
+#include <liblangutil/CharacterSearch.h>
+#include <liblangutil/Common.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <functional>
+
+using namespace std;
+
+namespace solidity::langutil::test
+{
+
+namespace
+{
+
+/// Checks @a _find against @a _stopsAt for every byte value at every offset of a run of
+/// @a _filler long enough for both the vectorised and the scalar part of the search.
+void checkSearch(function<size_t(string_view, size_t)> const& _find, function<bool(char)> const& _stopsAt, char _filler)
+{
+	BOOST_REQUIRE(!_stopsAt(_filler));
+	for (size_t length: {0u, 1u, 15u, 16u, 17u, 40u})
+	{
+		string text(length, _filler);
+		BOOST_CHECK_EQUAL(_find(text, 0), length);
+		for (size_t start = 0; start <= length; ++start)
+			BOOST_CHECK_EQUAL(_find(text, start), length);
+
+		for (size_t position = 0; position < length; ++position)
+			for (unsigned byte = 0; byte < 256; ++byte)
+			{
+				text[position] = static_cast<char>(byte);
+				size_t const expected = _stopsAt(static_cast<char>(byte)) ? position : length;
+				BOOST_CHECK_EQUAL(_find(text, 0), expected);
+				text[position] = _filler;
+			}
+	}
+}
+
+bool isLineTerminatorCandidate(char _c)
+{
+	return _c == '\n' || _c == '\v' || _c == '\f' || _c == '\r' || _c == '\xc2' || _c == '\xe2';
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CharacterSearchTest)
+
+BOOST_AUTO_TEST_CASE(non_white_space)
+{
+	checkSearch(findNonWhiteSpace, [](char _c) { return !isWhiteSpace(_c); }, ' ');
+	checkSearch(findNonWhiteSpace, [](char _c) { return !isWhiteSpace(_c); }, '\n');
+}
+
+BOOST_AUTO_TEST_CASE(non_identifier_part)
+{
+	for (bool allowDot: {false, true})
+		checkSearch(
+			[&](string_view _text, size_t _start) { return findNonIdentifierPart(_text, _start, allowDot); },
+			[&](char _c) { return !isIdentifierPart(_c) && !(allowDot && _c == '.'); },
+			'z'
+		);
+}
+
+BOOST_AUTO_TEST_CASE(non_hex_digit)
+{
+	checkSearch(findNonHexDigit, [](char _c) { return !isHexDigit(_c); }, 'F');
+}
+
+BOOST_AUTO_TEST_CASE(line_terminator_candidate)
+{
+	checkSearch(findLineTerminatorCandidate, isLineTerminatorCandidate, 'a');
+	checkSearch(findLineTerminatorCandidate, isLineTerminatorCandidate, '\xe9');
+}
+
+BOOST_AUTO_TEST_CASE(string_literal_special)
+{
+	for (char quote: {'"', '\''})
+		for (bool unicode: {false, true})
+			checkSearch(
+				[&](string_view _text, size_t _start) { return findStringLiteralSpecial(_text, _start, quote, unicode); },
+				[&](char _c) {
+					unsigned char const byte = static_cast<unsigned char>(_c);
+					return
+						_c == quote ||
+						_c == '\\' ||
+						isLineTerminatorCandidate(_c) ||
+						(!unicode && (byte < 0x20 || byte >= 0x7f));
+				},
+				'a'
+			);
+}
+
+BOOST_AUTO_TEST_CASE(comment_line_special)
+{
+	checkSearch(findCommentLineSpecial, [](char _c) { return _c == '\n' || _c == '\r' || _c == '*'; }, '/');
+}
+
+BOOST_AUTO_TEST_CASE(start_offset)
+{
+	string const text = "ab  cd    \n";
+	BOOST_CHECK_EQUAL(findNonWhiteSpace(text, 2), 4);
+	BOOST_CHECK_EQUAL(findNonWhiteSpace(text, 6), text.size());
+	BOOST_CHECK_EQUAL(findNonIdentifierPart(text, 4, false), 6);
+	BOOST_CHECK_EQUAL(findLineTerminatorCandidate(text, 0), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
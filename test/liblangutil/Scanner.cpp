@@ -22,10 +22,18 @@
 
 #include <liblangutil/Scanner.h>
 
+#include <libsolutil/MappedFile.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <test/FilesystemUtils.h>
+
 #include <boost/test/unit_test.hpp>
 
+#include <memory>
+
 using namespace std;
 using namespace solidity::langutil;
+using namespace solidity::test;
 
 namespace solidity::langutil::test
 {
@@ -1026,6 +1034,77 @@ BOOST_AUTO_TEST_CASE(yul_function_with_whitespace)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
 }
 
+BOOST_AUTO_TEST_CASE(long_runs)
+{
+	// Runs longer than the chunks of the bulk searches, ending at various offsets in a chunk.
+	for (size_t length: {15u, 16u, 17u, 31u, 32u, 33u, 100u})
+	{
+		string const run(length, 'x');
+		string const hexRun(2 * length, 'a');
+		CharStream stream(
+			string(length, ' ') + "a" + run + "\t\n" +
+			"\"" + run + "\\n" + run + "\" " +
+			"hex\"" + hexRun + "_" + hexRun + "\" " +
+			"// " + run + "\n" +
+			"/* " + run + "*" + run + " */ " +
+			"/** " + run + " * " + run + "\n * " + run + " */ b " +
+			"/// " + run + "\xe2\x80\xa7" + run + "\n" +
+			"c",
+			""
+		);
+		Scanner scanner(stream);
+		BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a" + run);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), run + "\n" + run);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::HexStringLiteral);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), string(2 * length, '\xaa'));
+		BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), "b");
+		BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), run + " * " + run + "\n " + run + " ");
+		BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), "c");
+		BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), run + "\xe2\x80\xa7" + run);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(mapped_files)
+{
+	// A mapped file is not followed by a terminating zero, so the scanner must not read past
+	// its end. The files end at a page boundary, in the middle of a token.
+	util::TemporaryDirectory tempDir("scanner-mapped-files");
+	createFileWithContent(tempDir.path() / "empty.sol", "");
+	CharStream emptyStream(make_shared<util::MappedFile const>(tempDir.path() / "empty.sol"), "empty.sol");
+	Scanner emptyScanner(emptyStream);
+	BOOST_CHECK_EQUAL(emptyScanner.currentToken(), Token::EOS);
+
+	size_t fileIndex = 0;
+	for (string_view end: {"abc", "0x12ab", "0x", "1e", "\"abc", "hex\"ab", "unicode\"ab", "// abc", "/* abc *", "/** abc"})
+	{
+		string const text = string(4096 - end.size(), ' ') + string(end);
+		boost::filesystem::path const path = tempDir.path() / ("test" + std::to_string(fileIndex++) + ".sol");
+		createFileWithContent(path, text);
+		CharStream mappedStream(make_shared<util::MappedFile const>(path), "test.sol");
+		BOOST_REQUIRE_EQUAL(mappedStream.source(), text);
+		CharStream stream(text, "test.sol");
+
+		Scanner mappedScanner(mappedStream);
+		Scanner scanner(stream);
+		while (true)
+		{
+			BOOST_CHECK_EQUAL(mappedScanner.currentToken(), scanner.currentToken());
+			BOOST_CHECK_EQUAL(mappedScanner.currentLiteral(), scanner.currentLiteral());
+			BOOST_CHECK_EQUAL(mappedScanner.currentCommentLiteral(), scanner.currentCommentLiteral());
+			BOOST_CHECK(mappedScanner.currentError() == scanner.currentError());
+			if (scanner.currentToken() == Token::EOS)
+				break;
+			mappedScanner.next();
+			scanner.next();
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
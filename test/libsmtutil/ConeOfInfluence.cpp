@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for the cone-of-influence slicing of conjunctions.
+
+#include <libsmtutil/ConeOfInfluence.h>
+#include <libsmtutil/SMTLib2Interface.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+Expression variable(string const& _name)
+{
+	return Expression(_name, {}, SortProvider::uintSort);
+}
+
+string toString(Expression const& _expr)
+{
+	return SMTLib2Interface().toSExpr(_expr);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ConeOfInfluenceTest)
+
+BOOST_AUTO_TEST_CASE(keeps_transitively_connected_conjuncts)
+{
+	Expression x = variable("x");
+	Expression y = variable("y");
+	Expression z = variable("z");
+	Expression w = variable("w");
+	Expression target = x > 10;
+	Expression query = (y == x + 1) && (z == y) && (w > 3) && (w < 5) && target;
+
+	SlicingStatistics statistics;
+	Expression sliced = coneOfInfluence(query, {target}, statistics);
+	BOOST_CHECK_EQUAL(toString(sliced), "(and (= y (+ x 1)) (and (= z y) (> x 10)))");
+	BOOST_CHECK_EQUAL(statistics.queries, 1);
+	BOOST_CHECK_EQUAL(statistics.conjuncts, 5);
+	BOOST_CHECK_EQUAL(statistics.keptConjuncts, 3);
+	BOOST_CHECK_EQUAL(statistics.nodes, 17);
+	BOOST_CHECK_EQUAL(statistics.keptNodes, 11);
+}
+
+BOOST_AUTO_TEST_CASE(keeps_conjuncts_without_variables)
+{
+	Expression x = variable("x");
+	Expression y = variable("y");
+	Expression target = x > 10;
+	Expression query = Expression(false) && (y > 1) && target;
+
+	SlicingStatistics statistics;
+	Expression sliced = coneOfInfluence(query, {target}, statistics);
+	BOOST_CHECK_EQUAL(toString(sliced), "(and false (> x 10))");
+	BOOST_CHECK_EQUAL(statistics.keptConjuncts, 2);
+}
+
+BOOST_AUTO_TEST_CASE(multiple_roots)
+{
+	Expression x = variable("x");
+	Expression y = variable("y");
+	Expression z = variable("z");
+	Expression pathCondition = y > 0;
+	Expression target = x > 10;
+	Expression query = pathCondition && (z > 2) && target;
+
+	SlicingStatistics statistics;
+	Expression sliced = coneOfInfluence(query, {pathCondition, target}, statistics);
+	BOOST_CHECK_EQUAL(toString(sliced), "(and (> y 0) (> x 10))");
+
+	sliced = coneOfInfluence(query, {target}, statistics);
+	BOOST_CHECK_EQUAL(toString(sliced), "(> x 10)");
+	BOOST_CHECK_EQUAL(statistics.queries, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,123 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for the concurrent modes of the SMT solver portfolio.
+
+#include <libsmtutil/SMTPortfolio.h>
+
+#ifdef HAVE_Z3
+#include <libsmtutil/Z3Interface.h>
+#endif
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <thread>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::smtutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+#ifdef HAVE_Z3
+BOOST_AUTO_TEST_CASE(race_loser_is_reusable)
+{
+	if (solidity::test::CommonOptions::get().disableSMT || !Z3Interface::available())
+		return;
+
+	bool answerViaCallback = true;
+	ReadCallback::Callback callback = [&](string const&, string const&) -> ReadCallback::Result
+	{
+		if (!answerViaCallback)
+			return {false, "not answered"};
+		// Answer only after z3 gave up on the query and became idle.
+		this_thread::sleep_for(chrono::milliseconds(1000));
+		return {true, "unsat\n"};
+	};
+	SMTSolverChoice solvers = SMTSolverChoice::None();
+	solvers.smtlib2 = true;
+	solvers.z3 = true;
+	SMTPortfolio portfolio({}, callback, solvers, 100, SMTPortfolio::Mode::Race);
+	BOOST_REQUIRE_EQUAL(portfolio.solvers(), 2u);
+
+	Expression a = Expression("a", {}, SortProvider::sintSort);
+	Expression b = Expression("b", {}, SortProvider::sintSort);
+	Expression c = Expression("c", {}, SortProvider::sintSort);
+	portfolio.declareVariable("a", SortProvider::sintSort);
+	portfolio.declareVariable("b", SortProvider::sintSort);
+	portfolio.declareVariable("c", SortProvider::sintSort);
+
+	// No solver can prove that this has no solution within the timeout.
+	portfolio.push();
+	portfolio.addAssertion(a > size_t(0) && b > size_t(0) && c > size_t(0));
+	portfolio.addAssertion(a * a * a + b * b * b == c * c * c);
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK_EQUAL(portfolio.lastQuery().solver, "smtlib2");
+	portfolio.pop();
+
+	// z3 was not interrupted while it was idle, so it still answers the next query.
+	answerViaCallback = false;
+	portfolio.push();
+	portfolio.addAssertion(a > size_t(1));
+	auto [result, values] = portfolio.check({a});
+	BOOST_CHECK(result == CheckResult::SATISFIABLE);
+	BOOST_CHECK_EQUAL(portfolio.lastQuery().solver, "z3");
+	BOOST_CHECK_EQUAL(values.size(), 1u);
+	portfolio.pop();
+}
+
+BOOST_AUTO_TEST_CASE(unknown_reason)
+{
+	if (solidity::test::CommonOptions::get().disableSMT || !Z3Interface::available())
+		return;
+
+	SMTPortfolio portfolio({}, {}, SMTSolverChoice::Z3(), 100, SMTPortfolio::Mode::Sequential);
+	Expression a = Expression("a", {}, SortProvider::sintSort);
+	Expression b = Expression("b", {}, SortProvider::sintSort);
+	Expression c = Expression("c", {}, SortProvider::sintSort);
+	portfolio.declareVariable("a", SortProvider::sintSort);
+	portfolio.declareVariable("b", SortProvider::sintSort);
+	portfolio.declareVariable("c", SortProvider::sintSort);
+
+	portfolio.push();
+	portfolio.addAssertion(a > size_t(0) && b > size_t(0) && c > size_t(0));
+	portfolio.addAssertion(a * a * a + b * b * b == c * c * c);
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::UNKNOWN);
+	BOOST_CHECK_EQUAL(portfolio.lastQuery().solver, "");
+	// Depending on the machine, z3 either runs out of time or gives up on the nonlinear arithmetic.
+	string const& reason = portfolio.lastQuery().unknownReason;
+	BOOST_CHECK_MESSAGE(reason == "timeout" || reason == "incomplete", reason);
+	portfolio.pop();
+
+	portfolio.push();
+	portfolio.addAssertion(a > size_t(1));
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::SATISFIABLE);
+	BOOST_CHECK_EQUAL(portfolio.lastQuery().solver, "z3");
+	BOOST_CHECK_EQUAL(portfolio.lastQuery().unknownReason, "");
+	portfolio.pop();
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for the persistent SMT query cache.
+
+#include <libsmtutil/SMTQueryCache.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace solidity::util;
+
+#define TEST_CASE_NAME (boost::unit_test::framework::current_test_case().p_name)
+
+namespace solidity::smtutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(SMTQueryCacheTest)
+
+BOOST_AUTO_TEST_CASE(lookup_missing)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	SMTQueryCache cache(tempDir.path() / "cache");
+
+	BOOST_TEST(!cache.lookup("z3 4.12.1", "(check-sat)").has_value());
+	BOOST_TEST(!boost::filesystem::exists(tempDir.path() / "cache"));
+}
+
+BOOST_AUTO_TEST_CASE(store_and_lookup)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	SMTQueryCache cache(tempDir.path() / "cache");
+
+	cache.store("z3 4.12.1", "(check-sat)", "unsat\n");
+	BOOST_TEST(boost::filesystem::is_directory(tempDir.path() / "cache"));
+	BOOST_TEST(cache.lookup("z3 4.12.1", "(check-sat)").value_or("") == "unsat\n");
+	BOOST_TEST(!cache.lookup("z3 4.12.1", "(assert false)(check-sat)").has_value());
+
+	// A new instance on the same directory sees the answers of the previous one.
+	SMTQueryCache otherCache(tempDir.path() / "cache");
+	BOOST_TEST(otherCache.lookup("z3 4.12.1", "(check-sat)").value_or("") == "unsat\n");
+
+	cache.store("z3 4.12.1", "(check-sat)", "sat\n");
+	BOOST_TEST(otherCache.lookup("z3 4.12.1", "(check-sat)").value_or("") == "sat\n");
+}
+
+BOOST_AUTO_TEST_CASE(solver_identity)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	SMTQueryCache cache(tempDir.path());
+
+	cache.store("z3 4.12.1 rlimit 1000000", "(check-sat)", "unsat\n");
+	BOOST_TEST(!cache.lookup("z3 4.12.2 rlimit 1000000", "(check-sat)").has_value());
+	BOOST_TEST(!cache.lookup("z3 4.12.1 timeout 1000", "(check-sat)").has_value());
+	BOOST_TEST(!cache.lookup("eld", "(check-sat)").has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,236 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for the query cache of the z3 Horn solver interface.
+
+#ifdef HAVE_Z3
+
+#include <libsmtutil/Z3CHCInterface.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <test/Common.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace solidity::util;
+
+#define TEST_CASE_NAME (boost::unit_test::framework::current_test_case().p_name)
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+/// The names of the relations and variables end in @a _suffix, like the AST node ids in the names CHC uses.
+Expression counter(Expression _value, string const& _suffix = "")
+{
+	return Expression("counter" + _suffix, {std::move(_value)}, SortProvider::boolSort);
+}
+
+Expression safeError(string const& _suffix = "")
+{
+	return Expression("safe_error" + _suffix, {}, SortProvider::boolSort);
+}
+
+Expression unsafeError(string const& _suffix = "")
+{
+	return Expression("unsafe_error" + _suffix, {}, SortProvider::boolSort);
+}
+
+/// Adds the system of a counter that counts from 0 to @a _bound to @a _solver.
+/// The error relation `safe_error` is unreachable, `unsafe_error` is reachable.
+void addCounterSystem(Z3CHCInterface& _solver, string const& _suffix = "", size_t _bound = 10)
+{
+	Expression x("x" + _suffix, {}, SortProvider::sintSort);
+	auto errorSort = make_shared<FunctionSort>(vector<SortPointer>{}, SortProvider::boolSort);
+	_solver.declareVariable("x" + _suffix, SortProvider::sintSort);
+	_solver.declareVariable("counter" + _suffix, make_shared<FunctionSort>(vector<SortPointer>{SortProvider::sintSort}, SortProvider::boolSort));
+	_solver.declareVariable("safe_error" + _suffix, errorSort);
+	_solver.declareVariable("unsafe_error" + _suffix, errorSort);
+	_solver.registerRelation(Expression("counter" + _suffix, {}, SortProvider::boolSort));
+	_solver.registerRelation(safeError(_suffix));
+	_solver.registerRelation(unsafeError(_suffix));
+	_solver.addRule(Expression::implies(x == size_t(0), counter(x, _suffix)), "init");
+	_solver.addRule(Expression::implies(counter(x, _suffix) && x < _bound, counter(x + size_t(1), _suffix)), "step");
+	_solver.addRule(Expression::implies(counter(x, _suffix) && x > size_t(20), safeError(_suffix)), "safe");
+	_solver.addRule(Expression::implies(counter(x, _suffix) && x == size_t(5), unsafeError(_suffix)), "unsafe");
+}
+
+string toString(Expression const& _expr)
+{
+	string result = "(" + _expr.name;
+	for (Expression const& argument: _expr.arguments)
+		result += " " + toString(argument);
+	return result + ")";
+}
+
+string toString(CHCSolverInterface::CexGraph const& _graph)
+{
+	string result;
+	for (auto const& [id, node]: _graph.nodes)
+		result += to_string(id) + ": " + toString(node) + "\n";
+	for (auto const& [id, children]: _graph.edges)
+	{
+		result += to_string(id) + " ->";
+		for (unsigned child: children)
+			result += " " + to_string(child);
+		result += "\n";
+	}
+	return result;
+}
+
+bool isAnswer(string const& _entry)
+{
+	return boost::starts_with(_entry, "sat\n") || boost::starts_with(_entry, "unsat\n");
+}
+
+/// Replaces the answers stored in @a _directory, leaving the stored lemmas alone.
+void replaceAnswers(boost::filesystem::path const& _directory, string const& _sat, string const& _unsat)
+{
+	for (auto const& entry: boost::filesystem::directory_iterator(_directory))
+	{
+		string answer = readFileAsString(entry.path());
+		if (boost::starts_with(answer, "sat\n"))
+			boost::filesystem::ofstream(entry.path()) << _sat;
+		else if (boost::starts_with(answer, "unsat\n"))
+			boost::filesystem::ofstream(entry.path()) << _unsat;
+	}
+}
+
+/// Replaces the lemmas stored in @a _directory and @returns the number of entries replaced.
+size_t replaceLemmas(boost::filesystem::path const& _directory, string const& _lemmas)
+{
+	size_t replaced = 0;
+	for (auto const& entry: boost::filesystem::directory_iterator(_directory))
+		if (!isAnswer(readFileAsString(entry.path())))
+		{
+			boost::filesystem::ofstream(entry.path()) << _lemmas;
+			++replaced;
+		}
+	return replaced;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(Z3CHCInterfaceTest)
+
+BOOST_AUTO_TEST_CASE(answers_are_cached)
+{
+	if (solidity::test::CommonOptions::get().disableSMT)
+		return;
+
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	auto cache = make_shared<SMTQueryCache>(tempDir.path());
+
+	Z3CHCInterface solver(nullopt, cache);
+	addCounterSystem(solver);
+	auto [safeResult, invariant, safeCex] = solver.queryWithCounterexample(safeError());
+	auto [unsafeResult, unsafeInvariant, cex] = solver.queryWithCounterexample(unsafeError());
+	BOOST_REQUIRE(safeResult == CheckResult::UNSATISFIABLE);
+	BOOST_REQUIRE(unsafeResult == CheckResult::SATISFIABLE);
+	BOOST_REQUIRE(!cex.nodes.empty());
+
+	// The answers read back from the cache are the ones computed above.
+	Z3CHCInterface cachedSolver(nullopt, cache);
+	addCounterSystem(cachedSolver);
+	auto [cachedSafeResult, cachedInvariant, cachedSafeCex] = cachedSolver.queryWithCounterexample(safeError());
+	auto [cachedUnsafeResult, cachedUnsafeInvariant, cachedCex] = cachedSolver.queryWithCounterexample(unsafeError());
+	BOOST_CHECK(cachedSafeResult == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK_EQUAL(toString(cachedInvariant), toString(invariant));
+	BOOST_CHECK(cachedUnsafeResult == CheckResult::SATISFIABLE);
+	BOOST_CHECK_EQUAL(toString(cachedCex), toString(cex));
+
+	// The answers are not computed again.
+	replaceAnswers(tempDir.path(), "sat\n", "unsat\n(assert true)\n");
+	Z3CHCInterface tamperedSolver(nullopt, cache);
+	addCounterSystem(tamperedSolver);
+	auto [tamperedSafeResult, tamperedInvariant, tamperedSafeCex] = tamperedSolver.queryWithCounterexample(safeError());
+	auto [tamperedUnsafeResult, tamperedUnsafeInvariant, tamperedCex] = tamperedSolver.queryWithCounterexample(unsafeError());
+	BOOST_CHECK(tamperedSafeResult == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK_EQUAL(toString(tamperedInvariant), "(true)");
+	BOOST_CHECK(tamperedUnsafeResult == CheckResult::SATISFIABLE);
+	BOOST_CHECK(tamperedCex.nodes.empty());
+
+	// Answers that cannot be parsed are computed again.
+	replaceAnswers(tempDir.path(), "sat\nnode x\n", "unsat\n(assert (undeclared))\n");
+	auto [parallelSafe, parallelUnsafe] = [&] {
+		Z3CHCInterface parallelSolver(nullopt, cache);
+		addCounterSystem(parallelSolver);
+		auto results = parallelSolver.queryInParallel({safeError(), unsafeError()}, 2);
+		return make_pair(results.at(0), results.at(1));
+	}();
+	BOOST_CHECK(get<0>(parallelSafe) == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(get<0>(parallelUnsafe) == CheckResult::SATISFIABLE);
+	// The ids of the nodes differ between z3 contexts.
+	BOOST_CHECK_EQUAL(get<2>(parallelUnsafe).nodes.size(), cex.nodes.size());
+}
+
+BOOST_AUTO_TEST_CASE(lemmas_are_keyed_per_relation)
+{
+	if (solidity::test::CommonOptions::get().disableSMT)
+		return;
+
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	auto cache = make_shared<SMTQueryCache>(tempDir.path());
+
+	Z3CHCInterface solver(nullopt, cache);
+	addCounterSystem(solver, "_1");
+	BOOST_REQUIRE(get<0>(solver.queryWithCounterexample(safeError("_1"))) == CheckResult::UNSATISFIABLE);
+
+	// Replacing the learned lemmas by `false` makes every relation they were learned for empty,
+	// so a reachable query is unreachable if they are used.
+	BOOST_REQUIRE_GT(replaceLemmas(tempDir.path(), "(assert false)\n"), 0);
+
+	// The lemmas are found although the names of the relations and variables differ,
+	// and the answer cache does not answer the query.
+	Z3CHCInterface renamedSolver(nullopt, cache);
+	addCounterSystem(renamedSolver, "_2");
+	BOOST_CHECK(get<0>(renamedSolver.queryWithCounterexample(unsafeError("_2"))) == CheckResult::UNSATISFIABLE);
+	auto parallelResults = [&] {
+		Z3CHCInterface parallelSolver(nullopt, cache);
+		addCounterSystem(parallelSolver, "_3");
+		return parallelSolver.queryInParallel({unsafeError("_3")}, 1);
+	}();
+	BOOST_CHECK(get<0>(parallelResults.at(0)) == CheckResult::UNSATISFIABLE);
+
+	// They are not used for a relation whose rules differ.
+	Z3CHCInterface changedSolver(nullopt, cache);
+	addCounterSystem(changedSolver, "_4", 7);
+	BOOST_CHECK(get<0>(changedSolver.queryWithCounterexample(unsafeError("_4"))) == CheckResult::SATISFIABLE);
+
+	// Lemmas that cannot be parsed are ignored.
+	replaceLemmas(tempDir.path(), "(assert (undeclared lemma#0))\n");
+	Z3CHCInterface unparsableSolver(nullopt, cache);
+	addCounterSystem(unparsableSolver, "_5");
+	BOOST_CHECK(get<0>(unparsableSolver.queryWithCounterexample(unsafeError("_5"))) == CheckResult::SATISFIABLE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+
+#endif
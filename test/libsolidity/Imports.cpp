@@ -25,11 +25,14 @@
 #include <test/Common.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolidity/ast/ASTJsonExporter.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/ImportRemapper.h>
+#include <libsolutil/JSON.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <map>
 #include <string>
 
 using namespace std;
@@ -113,6 +116,51 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(parallel_parsing_gives_same_ast)
+{
+	// Sources that are not given are loaded while the others are parsed.
+	map<string, string> const files{
+		{"lib/math.sol", "pragma solidity >=0.0; library Math { function max(uint a, uint b) internal pure returns (uint) { return a > b ? a : b; } }"},
+		{"lib/token.sol", "pragma solidity >=0.0; import \"lib/math.sol\"; contract Token { using Math for uint; mapping(address => uint) balances; function f(uint x) public view returns (uint) { return x.max(balances[msg.sender]); } }"}
+	};
+	ReadCallback::Callback readFile = [&](string const& _kind, string const& _path)
+	{
+		if (_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile) && files.count(_path))
+			return ReadCallback::Result{true, files.at(_path)};
+		return ReadCallback::Result{false, "File not found."};
+	};
+	map<string, string> const sources{
+		{"a.sol", "pragma solidity >=0.0; import \"lib/token.sol\"; contract A is Token { event E(uint indexed x); function g() public { emit E(f(1)); } }"},
+		{"b.sol", "pragma solidity >=0.0; import \"a.sol\"; import \"lib/math.sol\" as M; contract B is A { function h(uint[] calldata y) external pure returns (uint) { return M.Math.max(y.length, 2); } }"},
+		{"c.sol", "pragma solidity >=0.0; import {B} from \"b.sol\"; struct S { uint x; B b; } function free(S memory s) pure returns (uint) { return s.x; }"},
+		{"d.sol", "pragma solidity >=0.0; contract D { modifier m() { _; } function k() public m { assembly { let x := 1 } } }"}
+	};
+
+	auto astJson = [&](unsigned _threads)
+	{
+		CompilerStack c(readFile);
+		c.setSources(sources);
+		c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		c.setParserThreads(_threads);
+		BOOST_REQUIRE(c.parseAndAnalyze());
+		auto typeProviderScope = c.typeProviderScope();
+		map<string, string> asts;
+		for (string const& sourceName: c.sourceNames())
+			asts[sourceName] = util::jsonCompactPrint(ASTJsonExporter(c.state(), c.sourceIndices()).toJson(c.ast(sourceName)));
+		return asts;
+	};
+
+	map<string, string> const expected = astJson(1);
+	BOOST_REQUIRE_EQUAL(expected.size(), 6);
+	for (unsigned threads: {2u, 4u})
+	{
+		map<string, string> const asts = astJson(threads);
+		BOOST_REQUIRE_EQUAL(asts.size(), expected.size());
+		for (auto const& [sourceName, ast]: expected)
+			BOOST_CHECK_MESSAGE(asts.at(sourceName) == ast, "Different AST of " + sourceName + " with " + to_string(threads) + " threads.");
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
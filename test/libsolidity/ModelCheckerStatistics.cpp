@@ -0,0 +1,203 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for the statistics and progress reports of the model checker,
+ * and for the settings that must not change the outcome of the targets.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace solidity::smtutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+string const sourceCode = R"(
+	contract C {
+		function f(uint x) public pure {
+			assert(x > 0);
+		}
+		function g(uint x) public pure {
+			require(x > 1);
+			assert(x > 0);
+		}
+	}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(ModelCheckerStatistics)
+
+#ifdef HAVE_Z3
+BOOST_AUTO_TEST_CASE(target_statistics_and_progress)
+{
+	if (solidity::test::CommonOptions::get().disableSMT)
+		return;
+
+	for (string engine: {"bmc", "chc"})
+	{
+		BOOST_TEST_MESSAGE("Engine: " + engine);
+		CompilerStack compiler;
+		compiler.setSources({{"a.sol", sourceCode}});
+		compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		ModelCheckerSettings settings;
+		settings.engine = *ModelCheckerEngine::fromString(engine);
+		settings.targets = *ModelCheckerTargets::fromString("assert");
+		settings.solvers = SMTSolverChoice::Z3();
+		settings.statistics = true;
+		compiler.setModelCheckerSettings(settings);
+		vector<ModelCheckerTargetStatistics> progress;
+		compiler.setModelCheckerProgressCallback([&](ModelCheckerTargetStatistics const& _target) {
+			progress.emplace_back(_target);
+		});
+		BOOST_REQUIRE(compiler.parseAndAnalyze());
+
+		// Every checked target is reported to the callback, in the order of the statistics.
+		auto const& targets = compiler.modelCheckerTargetStatistics();
+		BOOST_REQUIRE_EQUAL(targets.size(), 2u);
+		BOOST_REQUIRE_EQUAL(progress.size(), targets.size());
+		map<string, string> results;
+		for (size_t i = 0; i < targets.size(); ++i)
+		{
+			BOOST_CHECK_EQUAL(progress[i].toString(""), targets[i].toString(""));
+			BOOST_CHECK_EQUAL(targets[i].engine, engine == "bmc" ? "BMC" : "CHC");
+			BOOST_CHECK_EQUAL(targets[i].typeString(), "assert");
+			BOOST_CHECK_EQUAL(targets[i].solver, "z3");
+			BOOST_CHECK(targets[i].unknownReason.empty());
+			BOOST_CHECK(targets[i].location.hasText());
+			results[targets[i].function] = targets[i].resultString();
+		}
+		BOOST_CHECK_EQUAL(results["C.f"], "unsafe");
+		BOOST_CHECK_EQUAL(results["C.g"], "safe");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(progress_without_statistics)
+{
+	if (solidity::test::CommonOptions::get().disableSMT)
+		return;
+
+	CompilerStack compiler;
+	compiler.setSources({{"a.sol", sourceCode}});
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	ModelCheckerSettings settings;
+	settings.engine = ModelCheckerEngine::All();
+	settings.targets = *ModelCheckerTargets::fromString("assert");
+	settings.solvers = SMTSolverChoice::Z3();
+	compiler.setModelCheckerSettings(settings);
+	size_t reported = 0;
+	compiler.setModelCheckerProgressCallback([&](ModelCheckerTargetStatistics const&) { ++reported; });
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+
+	BOOST_CHECK_GE(reported, 2u);
+	BOOST_CHECK(compiler.modelCheckerTargetStatistics().empty());
+}
+
+BOOST_AUTO_TEST_CASE(incremental_bmc_gives_same_results)
+{
+	if (solidity::test::CommonOptions::get().disableSMT)
+		return;
+
+	string const contract = R"(
+		contract C {
+			uint x;
+			uint[] a;
+			mapping(address => uint) balances;
+			function inc(uint8 y) public {
+				require(x < 100);
+				x += y;
+				assert(x < 400);
+				assert(x < 200);
+			}
+			function push(uint v) public {
+				a.push(v);
+				assert(a.length > 0);
+				assert(a[a.length - 1] == v + 1);
+			}
+			function transfer(address to, uint amount) public {
+				require(balances[msg.sender] >= amount);
+				balances[msg.sender] -= amount;
+				balances[to] += amount;
+				assert(balances[to] >= amount);
+			}
+			function div(uint p, uint q) public pure returns (uint) {
+				if (q > 2)
+					return p / q;
+				return p / (q - 1);
+			}
+		}
+	)";
+
+	auto check = [&](bool _incremental)
+	{
+		CompilerStack compiler;
+		compiler.setSources({{"a.sol", contract}});
+		compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		ModelCheckerSettings settings;
+		settings.engine = ModelCheckerEngine::BMC();
+		settings.targets = ModelCheckerTargets::All();
+		settings.solvers = SMTSolverChoice::Z3();
+		settings.incremental = _incremental;
+		settings.statistics = true;
+		compiler.setModelCheckerSettings(settings);
+		BOOST_REQUIRE(compiler.parseAndAnalyze());
+
+		map<tuple<string, string, int>, string> results;
+		for (auto const& target: compiler.modelCheckerTargetStatistics())
+			results[{target.function, target.typeString(), target.location.start}] = target.resultString();
+		set<pair<uint64_t, int>> warnings;
+		for (auto const& error: compiler.errors())
+			warnings.emplace(error->errorId().error, error->sourceLocation() ? error->sourceLocation()->start : -1);
+		size_t assertedNodes = compiler.modelCheckerSolverStatistics().at("BMC").at("z3").assertedNodes;
+		return make_tuple(results, warnings, assertedNodes);
+	};
+
+	auto [results, warnings, assertedNodes] = check(false);
+	auto [incrementalResults, incrementalWarnings, incrementalAssertedNodes] = check(true);
+
+	BOOST_REQUIRE_GE(results.size(), 8u);
+	BOOST_CHECK(results == incrementalResults);
+	BOOST_CHECK(warnings == incrementalWarnings);
+	// Every function has several targets, so asserting the shared constraints once pays off.
+	BOOST_CHECK_LT(incrementalAssertedNodes, assertedNodes);
+
+	set<string> outcomes;
+	for (auto const& [target, result]: results)
+		outcomes.insert(result);
+	BOOST_CHECK(outcomes.count("safe"));
+	BOOST_CHECK(outcomes.count("unsafe"));
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
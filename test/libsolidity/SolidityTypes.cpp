@@ -24,9 +24,12 @@
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/CompilerStack.h>
 #include <libsolutil/Keccak256.h>
 #include <boost/test/unit_test.hpp>
 
+#include <optional>
+
 using namespace std;
 using namespace solidity::langutil;
 
@@ -222,6 +225,96 @@ BOOST_AUTO_TEST_CASE(type_identifiers)
 	BOOST_CHECK_EQUAL(InaccessibleDynamicType().identifier(), "t_inaccessible");
 }
 
+BOOST_AUTO_TEST_CASE(interned_types)
+{
+	TypeProvider provider;
+	TypeProvider::Scope scope(provider);
+
+	Type const* uint8 = TypeProvider::uint(8);
+	ArrayType const* array = TypeProvider::array(DataLocation::Memory, uint8, 3);
+	BOOST_CHECK_EQUAL(array, TypeProvider::array(DataLocation::Memory, uint8, 3));
+	BOOST_CHECK(array != TypeProvider::array(DataLocation::Memory, uint8, 4));
+	BOOST_CHECK(array != TypeProvider::array(DataLocation::Memory, uint8));
+	BOOST_CHECK_EQUAL(TypeProvider::withLocation(array, DataLocation::CallData, true), TypeProvider::withLocation(array, DataLocation::CallData, true));
+
+	TupleType const* tuple = TypeProvider::tuple({array, uint8});
+	BOOST_CHECK_EQUAL(tuple, TypeProvider::tuple({array, uint8}));
+
+	MappingType const* mapping = TypeProvider::mapping(uint8, "key", array, "");
+	BOOST_CHECK_EQUAL(mapping, TypeProvider::mapping(uint8, "key", array, ""));
+	BOOST_CHECK(mapping != TypeProvider::mapping(uint8, "", array, ""));
+
+	FunctionType const* function = TypeProvider::function(TypePointers{array}, TypePointers{uint8}, strings{""}, strings{""});
+	BOOST_CHECK_EQUAL(function, TypeProvider::function(TypePointers{array}, TypePointers{uint8}, strings{""}, strings{""}));
+	BOOST_CHECK(function != TypeProvider::function(TypePointers{array}, TypePointers{uint8}, strings{""}, strings{""}, FunctionType::Kind::External));
+
+	TypeProvider::Statistics const& statistics = TypeProvider::statistics();
+	BOOST_CHECK_EQUAL(statistics.requests, 14);
+	BOOST_CHECK_EQUAL(statistics.hits, 5);
+	BOOST_CHECK_EQUAL(statistics.types, 9);
+}
+
+BOOST_AUTO_TEST_CASE(interned_types_of_destroyed_nodes)
+{
+	TypeProvider provider;
+	TypeProvider::Scope scope(provider);
+
+	// Both contracts are constructed at the same address.
+	optional<ContractDefinition> contract;
+	contract.emplace(1, SourceLocation{}, make_shared<string>("A"), SourceLocation{}, nullptr, vector<ASTPointer<InheritanceSpecifier>>{}, vector<ASTPointer<ASTNode>>{});
+	BOOST_CHECK_EQUAL(TypeProvider::contract(*contract)->contractDefinition().name(), "A");
+	BOOST_CHECK_EQUAL(TypeProvider::contract(*contract), TypeProvider::contract(*contract));
+
+	contract.emplace(1, SourceLocation{}, make_shared<string>("B"), SourceLocation{}, nullptr, vector<ASTPointer<InheritanceSpecifier>>{}, vector<ASTPointer<ASTNode>>{});
+	BOOST_CHECK_EQUAL(TypeProvider::contract(*contract)->contractDefinition().name(), "B");
+	BOOST_CHECK_EQUAL(TypeProvider::statistics().hits, 2);
+	BOOST_CHECK_EQUAL(TypeProvider::statistics().types, 2);
+}
+
+BOOST_AUTO_TEST_CASE(type_provider_scopes)
+{
+	TypeProvider outer;
+	TypeProvider inner;
+	IntegerType const* outerType = nullptr;
+	{
+		TypeProvider::Scope outerScope(outer);
+		outerType = TypeProvider::uint256();
+		{
+			TypeProvider::Scope innerScope(inner);
+			BOOST_CHECK(TypeProvider::uint256() != outerType);
+			BOOST_CHECK(*TypeProvider::uint256() == *outerType);
+		}
+		BOOST_CHECK_EQUAL(TypeProvider::uint256(), outerType);
+	}
+	BOOST_CHECK(TypeProvider::uint256() != outerType);
+}
+
+BOOST_AUTO_TEST_CASE(compiler_stacks_use_their_own_types)
+{
+	CompilerStack first;
+	CompilerStack second;
+	first.setSources({{"a.sol", "contract A { function f(uint[] memory) public {} }"}});
+	second.setSources({{"b.sol", "contract B { function g(uint[] memory) public {} }"}});
+
+	BOOST_REQUIRE(first.parseAndAnalyze());
+	size_t requests = 0;
+	{
+		auto scope = first.typeProviderScope();
+		requests = TypeProvider::statistics().requests;
+	}
+	BOOST_CHECK_GT(requests, 0);
+
+	BOOST_REQUIRE(second.parseAndAnalyze());
+	{
+		auto scope = first.typeProviderScope();
+		BOOST_CHECK_EQUAL(TypeProvider::statistics().requests, requests);
+	}
+
+	// Resetting one stack does not invalidate the types of the other one.
+	second.reset();
+	BOOST_CHECK_EQUAL(first.contractABI("A")[0]["name"].asString(), "f");
+}
+
 BOOST_AUTO_TEST_CASE(encoded_sizes)
 {
 	BOOST_CHECK_EQUAL(IntegerType(16).calldataEncodedSize(true), 32);
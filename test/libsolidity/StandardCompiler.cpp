@@ -27,6 +27,7 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/StringUtils.h>
 #include <test/Metadata.h>
 
 #include <algorithm>
@@ -1621,7 +1622,7 @@ BOOST_AUTO_TEST_CASE(stopAfter_invalid_value)
 	}
 	)";
 	Json::Value result = compile(input);
-	BOOST_CHECK(containsError(result, "JSONError", "Invalid value for \"settings.stopAfter\". Only valid value is \"parsing\"."));
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid value for \"settings.stopAfter\". Valid values are \"parsing\" and \"analysis\"."));
 }
 
 BOOST_AUTO_TEST_CASE(stopAfter_invalid_type)
@@ -1688,6 +1689,87 @@ BOOST_AUTO_TEST_CASE(stopAfter_ast_output)
 	BOOST_CHECK(result["sources"]["a.sol"]["ast"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(stopAfter_analysis)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract C { function f() public returns (uint) { return 1; } }"
+			}
+		},
+		"settings": {
+			"stopAfter": "analysis",
+			"outputSelection": { "*": { "*": [ "abi" ], "": [ "ast" ] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(containsError(result, "Warning", "Function state mutability can be restricted to pure"));
+	BOOST_CHECK(result["sources"]["a.sol"]["ast"].isObject());
+	BOOST_CHECK(result["contracts"]["a.sol"]["C"]["abi"].isArray());
+	BOOST_CHECK(!result["contracts"]["a.sol"]["C"].isMember("evm"));
+}
+
+BOOST_AUTO_TEST_CASE(stopAfter_analysis_bin_conflict)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"stopAfter": "analysis",
+			"outputSelection":
+			{
+				"*": { "C": ["evm.deployedBytecode"] }
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Requested output selection conflicts with \"settings.stopAfter\"."));
+}
+
+BOOST_AUTO_TEST_CASE(ast_binary_output)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\ncontract C { function f() public pure returns (int) { return -1; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": { "*": { "": [ "ast", "astBinary" ] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(result["sources"]["a.sol"]["astBinary"].isString());
+
+	Json::Value astFile;
+	string binary = util::asString(util::fromHex(result["sources"]["a.sol"]["astBinary"].asString()));
+	BOOST_REQUIRE(util::jsonBinaryParse(binary, astFile));
+	BOOST_CHECK_EQUAL(
+		util::jsonCompactPrint(astFile["sources"]["a.sol"]["ast"]),
+		util::jsonCompactPrint(result["sources"]["a.sol"]["ast"])
+	);
+
+	// The wildcard does not select the binary AST.
+	Json::Value wildcardInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, wildcardInput));
+	wildcardInput["settings"]["outputSelection"]["*"][""] = Json::arrayValue;
+	wildcardInput["settings"]["outputSelection"]["*"][""].append("*");
+	Json::Value wildcardResult = compile(util::jsonCompactPrint(wildcardInput));
+	BOOST_CHECK(wildcardResult["sources"]["a.sol"]["ast"].isObject());
+	BOOST_CHECK(!wildcardResult["sources"]["a.sol"].isMember("astBinary"));
+}
+
 BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract)
 {
 	char const* input = R"(
@@ -1815,6 +1897,153 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(model_checker_solver_statistics_per_engine)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract C { function f(uint x) public pure { assert(x > 0); } }"
+			}
+		},
+		"settings": {
+			"modelChecker": {
+				"engine": "all",
+				"solvers": ["smtlib2"],
+				"statistics": true
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(result["auxiliaryInputRequested"]["smtlib2queries"].isObject());
+	Json::Value const& solvers = result["modelChecker"]["statistics"]["solvers"];
+	BOOST_REQUIRE(solvers.isObject());
+	BOOST_CHECK_EQUAL(util::joinHumanReadable(solvers.getMemberNames()), "BMC, CHC");
+
+	for (string engine: {"BMC", "CHC"})
+	{
+		BOOST_REQUIRE_MESSAGE(solvers[engine]["smtlib2"].isObject(), engine);
+		Json::Value const& statistics = solvers[engine]["smtlib2"];
+		BOOST_CHECK_GT(statistics["queries"].asUInt64(), 0);
+		BOOST_CHECK_GT(statistics["largestQueryBytes"].asUInt64(), 0);
+		BOOST_CHECK_GE(statistics["queryBytes"].asUInt64(), statistics["largestQueryBytes"].asUInt64());
+
+		// The queries of the targets of an engine are part of the queries of that engine only.
+		uint64_t targetBytes = 0;
+		for (Json::Value const& target: result["modelChecker"]["statistics"]["targets"])
+			if (target["engine"].asString() == engine)
+				targetBytes += target["queryBytes"].asUInt64();
+		BOOST_CHECK_GT(targetBytes, 0);
+		BOOST_CHECK_LE(targetBytes, statistics["queryBytes"].asUInt64());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	// The contract names are not ordered like the fully qualified names "a.sol.x:A" and "a.sol:B".
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {
+				"content": "contract B { function f() public pure returns (uint x) {} } contract A is B {}"
+			},
+			"a.sol.x": {
+				"content": "import {B} from \"a.sol\"; contract A { function g() public { uint x; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": ["abi", "evm.legacyAssembly", "evm.bytecode.object"],
+					"": ["ast"]
+				}
+			}
+		}
+	}
+	)";
+	char const* invalidInput = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": { "content": "contract A {" }
+		}
+	}
+	)";
+
+	for (char const* source: {input, invalidInput})
+	{
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(source, parsedInput));
+
+		solidity::frontend::StandardCompiler compiler;
+		string expected = util::jsonCompactPrint(compiler.compile(parsedInput));
+		ostringstream output;
+		compiler.compile(string(source), output);
+		BOOST_CHECK_EQUAL(output.str(), expected);
+		BOOST_CHECK_EQUAL(compiler.compile(string(source)), expected);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_error)
+{
+	// Stream buffer that fails once, at the first write after @a m_failAfter was written.
+	class FailingStreamBuffer: public stringbuf
+	{
+	public:
+		explicit FailingStreamBuffer(string _failAfter): m_failAfter(std::move(_failAfter)) {}
+
+	protected:
+		streamsize xsputn(char const* _data, streamsize _size) override
+		{
+			if (!m_failed && str().find(m_failAfter) != string::npos)
+			{
+				m_failed = true;
+				throw runtime_error("Write failed.");
+			}
+			return stringbuf::xsputn(_data, _size);
+		}
+
+	private:
+		string m_failAfter;
+		bool m_failed = false;
+	};
+
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": { "content": "contract A { function f() public { uint x; } } contract B {}" }
+		},
+		"settings": {
+			"outputSelection": { "*": { "*": ["abi"], "": ["ast"] } }
+		}
+	}
+	)";
+
+	FailingStreamBuffer buffer("\"a.sol\":{\"A\":");
+	ostream output(&buffer);
+	// Let the exception of the stream buffer through.
+	output.exceptions(ios::badbit);
+	solidity::frontend::StandardCompiler compiler;
+	compiler.compile(string(input), output);
+
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(buffer.str(), result));
+	BOOST_CHECK(result["contracts"]["a.sol"]["A"].isNull());
+	BOOST_CHECK(!result["contracts"]["a.sol"].isMember("B"));
+	BOOST_CHECK(!result.isMember("sources"));
+	Json::Value const& errors = result["errors"];
+	// The warnings of the compilation are kept.
+	BOOST_REQUIRE_GE(errors.size(), 2);
+	BOOST_CHECK_EQUAL(errors[0]["type"], "Warning");
+	Json::Value const& error = errors[errors.size() - 1];
+	BOOST_CHECK_EQUAL(error["type"], "InternalCompilerError");
+	BOOST_CHECK(error["message"].asString().find("Write failed.") != string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
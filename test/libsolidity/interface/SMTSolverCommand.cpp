@@ -0,0 +1,176 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for the process pool of libsolidity/interface/SMTSolverCommand.h
+
+#include <libsolidity/interface/SMTSolverCommand.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace solidity::frontend::test
+{
+
+#ifndef _WIN32
+
+namespace
+{
+
+/// Stand-in for a solver in interactive mode. It answers `sat` to `(check-sat)` unless
+/// `(assert unsat)` was given since the last `(reset)`, hangs on `(hang)`, exits on `(exit)`
+/// and records every start in the file `starts` next to it.
+string const standInSolver = R"SH(#!/bin/sh
+echo started >> "$(dirname "$0")/starts"
+answer=sat
+while IFS= read -r line; do
+	case "$line" in
+		"(assert unsat)") answer=unsat ;;
+		"(check-sat)") echo "$answer" ;;
+		"(reset)") answer=sat ;;
+		"(hang)") exec sleep 60 ;;
+		"(exit)") exit 1 ;;
+		"(echo \""*) marker=${line#(echo \"}; echo "${marker%\")}" ;;
+	esac
+done
+)SH";
+
+class StandInSolverFixture
+{
+public:
+	StandInSolverFixture()
+	{
+		boost::filesystem::path solver = m_tempDir.path() / "solver";
+		boost::filesystem::ofstream(solver) << standInSolver;
+		boost::filesystem::permissions(solver, boost::filesystem::owner_all);
+		m_solverCommand = make_unique<SMTSolverCommand>(solver.string());
+	}
+
+	ReadCallback::Result solve(string const& _query)
+	{
+		return m_solverCommand->solve(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _query);
+	}
+
+	size_t starts() const
+	{
+		string starts = readFileAsString(m_tempDir.path() / "starts");
+		return static_cast<size_t>(count(starts.begin(), starts.end(), '\n'));
+	}
+
+protected:
+	TemporaryDirectory m_tempDir{"smt-solver-command-test"};
+	unique_ptr<SMTSolverCommand> m_solverCommand;
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(SMTSolverCommandTest, StandInSolverFixture)
+
+BOOST_AUTO_TEST_CASE(process_pool_reuses_processes)
+{
+	m_solverCommand->setProcessPool(1);
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		ReadCallback::Result result = solve("(assert unsat)\n(check-sat)");
+		BOOST_TEST(result.success);
+		BOOST_TEST(result.responseOrErrorMessage == "unsat");
+
+		// The previous query was reset.
+		result = solve("(check-sat)");
+		BOOST_TEST(result.success);
+		BOOST_TEST(result.responseOrErrorMessage == "sat");
+	}
+	BOOST_TEST(starts() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(process_pool_timeout)
+{
+	m_solverCommand->setProcessPool(1, chrono::milliseconds(200));
+
+	ReadCallback::Result result = solve("(hang)\n(check-sat)");
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.responseOrErrorMessage == "unknown");
+
+	result = solve("(check-sat)");
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.responseOrErrorMessage == "sat");
+	BOOST_TEST(starts() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(process_pool_replaces_exited_processes)
+{
+	m_solverCommand->setProcessPool(1);
+
+	// The query is sent to a second process before giving up.
+	ReadCallback::Result result = solve("(exit)\n(check-sat)");
+	BOOST_TEST(!result.success);
+	BOOST_TEST(starts() == 2);
+
+	result = solve("(check-sat)");
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.responseOrErrorMessage == "sat");
+	BOOST_TEST(starts() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(process_pool_concurrent_queries)
+{
+	m_solverCommand->setProcessPool(2, chrono::milliseconds(1000));
+
+	// While the first query is answered by one process, the second one needs another.
+	ReadCallback::Result slowResult;
+	thread slowQuery([&] { slowResult = solve("(hang)\n(check-sat)"); });
+	this_thread::sleep_for(chrono::milliseconds(200));
+	ReadCallback::Result result = solve("(check-sat)");
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.responseOrErrorMessage == "sat");
+	BOOST_TEST(starts() == 2);
+	slowQuery.join();
+	BOOST_TEST(slowResult.responseOrErrorMessage == "unknown");
+}
+
+BOOST_AUTO_TEST_CASE(solver_version)
+{
+	string const versionKind = ReadCallback::kindString(ReadCallback::Kind::SMTSolverVersion);
+	ReadCallback::Result version = m_solverCommand->solve(versionKind, "");
+	BOOST_TEST(version.success);
+	BOOST_TEST(!version.responseOrErrorMessage.empty());
+	BOOST_TEST(m_solverCommand->solve(versionKind, "").responseOrErrorMessage == version.responseOrErrorMessage);
+	// Asking for the version does not run the solver.
+	BOOST_TEST(!boost::filesystem::exists(m_tempDir.path() / "starts"));
+
+	// Updating the solver changes its version.
+	boost::filesystem::ofstream(m_tempDir.path() / "solver", ios::app) << "# updated\n";
+	BOOST_TEST(m_solverCommand->solve(versionKind, "").responseOrErrorMessage != version.responseOrErrorMessage);
+
+	BOOST_TEST(!SMTSolverCommand("solver-that-does-not-exist").solve(versionKind, "").success);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
+
+}
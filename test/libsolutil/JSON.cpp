@@ -26,6 +26,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <limits>
+
 using namespace std;
 
 namespace solidity::util::test
@@ -118,6 +120,73 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2},\"4\":\"\\u0911 \\u0912 \\u0913 \\u0914 \\u0915 \\u0916\",\"5\":\"\\ufffd\"}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+	Json::Value json;
+	json["a"] = Json::arrayValue;
+	json["b"]["c"] = "ऑ\n";
+	json["b"]["d"] = Json::objectValue;
+	json["e"] = 1.5;
+
+	ostringstream output;
+	JsonStreamWriter writer(output);
+	writer.beginObject();
+	writer.key("a");
+	writer.beginArray();
+	writer.endArray();
+	writer.key("b");
+	writer.beginObject();
+	writer.member("c", json["b"]["c"]);
+	writer.key("d");
+	writer.beginObject();
+	writer.endObject();
+	writer.endObject();
+	BOOST_CHECK_THROW(writer.key("a"), JsonStreamWriterError);
+	writer.member("e", json["e"]);
+	writer.endObject();
+	BOOST_CHECK_THROW(writer.beginArray(), JsonStreamWriterError);
+
+	BOOST_CHECK_EQUAL(output.str(), jsonCompactPrint(json));
+
+	ostringstream arrayOutput;
+	JsonStreamWriter arrayWriter(arrayOutput);
+	arrayWriter.beginArray();
+	arrayWriter.value(1);
+	arrayWriter.value(json);
+	arrayWriter.beginArray();
+	arrayWriter.value("x");
+	arrayWriter.endArray();
+	BOOST_CHECK_THROW(arrayWriter.key("a"), JsonStreamWriterError);
+	arrayWriter.endArray();
+
+	Json::Value array = Json::arrayValue;
+	array.append(1);
+	array.append(json);
+	array.append(Json::arrayValue);
+	array[2].append("x");
+	BOOST_CHECK_EQUAL(arrayOutput.str(), jsonCompactPrint(array));
+}
+
+BOOST_AUTO_TEST_CASE(json_stream_writer_end_after_error)
+{
+	ostringstream output;
+	JsonStreamWriter writer(output);
+	writer.beginObject();
+	writer.key("a");
+	writer.beginArray();
+	writer.value(1);
+	writer.beginObject();
+	writer.key("b");
+	BOOST_CHECK_EQUAL(writer.depth(), 3);
+	BOOST_CHECK_THROW(writer.endAfterError(4), JsonStreamWriterError);
+	writer.endAfterError(1);
+	BOOST_CHECK_EQUAL(writer.depth(), 1);
+	BOOST_CHECK(writer.lastKey() == "a");
+	writer.member("c", "x");
+	writer.endObject();
+	BOOST_CHECK_EQUAL(output.str(), "{\"a\":[1,{\"b\":null}],\"c\":\"x\"}");
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
@@ -184,6 +253,48 @@ BOOST_AUTO_TEST_CASE(parse_json_strict)
 	BOOST_CHECK(json[0] == "😊");
 }
 
+BOOST_AUTO_TEST_CASE(json_binary)
+{
+	Json::Value json;
+	json["null"] = Json::nullValue;
+	json["bool"] = Json::arrayValue;
+	json["bool"].append(true);
+	json["bool"].append(false);
+	json["int"] = Json::arrayValue;
+	json["int"].append(0);
+	json["int"].append(-1);
+	json["int"].append(numeric_limits<Json::Int64>::min());
+	json["int"].append(numeric_limits<Json::Int64>::max());
+	json["uint"] = Json::arrayValue;
+	json["uint"].append(Json::UInt(7));
+	json["uint"].append(numeric_limits<Json::UInt64>::max());
+	json["real"] = -0.25;
+	json["string"] = string("a\0b", 3);
+	json["nested"]["string"] = "ऑ\n";
+	json["nested"]["empty"] = Json::objectValue;
+	json["nested"][string("\0", 1)] = "string";
+
+	string binary = jsonBinaryPrint(json);
+	BOOST_CHECK(isJsonBinary(binary));
+	BOOST_CHECK(!isJsonBinary(jsonCompactPrint(json)));
+
+	Json::Value parsed;
+	string errors;
+	BOOST_REQUIRE(jsonBinaryParse(binary, parsed, &errors));
+	BOOST_CHECK_EQUAL(errors, "");
+	BOOST_CHECK(parsed == json);
+	BOOST_CHECK_EQUAL(jsonCompactPrint(parsed), jsonCompactPrint(json));
+	BOOST_CHECK(parsed["int"][0].isInt());
+	BOOST_CHECK(parsed["uint"][0].isUInt());
+	BOOST_CHECK(parsed["uint"][0].type() == Json::uintValue);
+
+	for (size_t length = 0; length < binary.size(); ++length)
+		BOOST_CHECK(!jsonBinaryParse(binary.substr(0, length), parsed));
+	BOOST_CHECK(!jsonBinaryParse(binary + '\0', parsed, &errors));
+	BOOST_CHECK_EQUAL(errors, "Offset " + to_string(binary.size()) + ": Unexpected data after the end of the document.");
+	BOOST_CHECK(!jsonBinaryParse("{}", parsed));
+}
+
 BOOST_AUTO_TEST_CASE(json_isOfType)
 {
 	Json::Value json;
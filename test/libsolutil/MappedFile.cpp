@@ -0,0 +1,66 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for MappedFile.
+
+#include <libsolutil/MappedFile.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <test/Common.h>
+#include <test/FilesystemUtils.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::test;
+
+#define TEST_CASE_NAME (boost::unit_test::framework::current_test_case().p_name)
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(MappedFileTest)
+
+BOOST_AUTO_TEST_CASE(regular_file)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	createFileWithContent(tempDir.path() / "test.txt", "ABC\ndef\n");
+
+	BOOST_TEST(MappedFile(tempDir.path() / "test.txt").contents() == "ABC\ndef\n");
+}
+
+BOOST_AUTO_TEST_CASE(empty_file)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	createFileWithContent(tempDir.path() / "empty.txt", "");
+
+	BOOST_TEST(MappedFile(tempDir.path() / "empty.txt").contents().empty());
+}
+
+BOOST_AUTO_TEST_CASE(missing_file_and_directory)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+
+	BOOST_CHECK_THROW(MappedFile(tempDir.path() / "missing.txt"), FileNotFound);
+	BOOST_CHECK_THROW(MappedFile(tempDir.path()), NotAFile);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace solidity::util::test
@@ -1369,6 +1369,35 @@ BOOST_AUTO_TEST_CASE(cli_include_paths_ambiguous_import)
 	BOOST_REQUIRE(!result.success);
 }
 
+BOOST_AUTO_TEST_CASE(cli_ast_binary_import)
+{
+	TemporaryDirectory tempDir({"output"}, TEST_CASE_NAME);
+	createFileWithContent(
+		tempDir.path() / "a.sol",
+		"// SPDX-License-Identifier: GPL-3.0\n"
+		"pragma solidity >=0.0;\n"
+		"contract C { function f() public pure returns (int) { return -1; } }\n"
+	);
+	string const inputPath = (tempDir.path() / "a.sol").string();
+	string const outputDir = (tempDir.path() / "output").string();
+
+	OptionsReaderAndMessages direct = runCLI({"solc", inputPath, "--ast-compact-json"});
+	BOOST_REQUIRE(direct.success);
+
+	OptionsReaderAndMessages exported = runCLI({"solc", inputPath, "--ast-binary", "--output-dir", outputDir});
+	BOOST_REQUIRE(exported.success);
+	BOOST_REQUIRE(boost::filesystem::exists(tempDir.path() / "output" / "a.sol_binary.ast"));
+
+	OptionsReaderAndMessages imported = runCLI({
+		"solc",
+		"--import-ast",
+		(tempDir.path() / "output" / "a.sol_binary.ast").string(),
+		"--ast-compact-json",
+	});
+	BOOST_REQUIRE(imported.success);
+	BOOST_TEST(imported.stdoutContent == direct.stdoutContent);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace solidity::frontend::test
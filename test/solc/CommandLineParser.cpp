@@ -117,6 +117,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--allow-paths=/tmp,/home,project,../contracts",
 			"--ignore-missing",
 			"--error-recovery",
+			"--parser-threads=3",
 			"--output-dir=/tmp/out",
 			"--overwrite",
 			"--evm-version=spuriousDragon",
@@ -133,6 +134,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
 			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
 			"--ir", "--ir-optimized", "--ewasm", "--hashes", "--userdoc", "--devdoc", "--metadata", "--storage-layout",
+			"--ast-binary",
 			"--gas",
 			"--combined-json="
 				"abi,metadata,bin,bin-runtime,opcodes,asm,storage-layout,generated-sources,generated-sources-runtime,"
@@ -142,14 +144,21 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--model-checker-cache=smt-cache",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
 			"--model-checker-ext-calls=trusted",
+			"--model-checker-incremental",
 			"--model-checker-invariants=contract,reentrancy",
+			"--model-checker-portfolio=race",
+			"--model-checker-progress",
 			"--model-checker-show-unproved",
+			"--model-checker-slice-queries",
 			"--model-checker-solvers=z3,smtlib2",
+			"--model-checker-statistics",
 			"--model-checker-targets=underflow,divByZero",
+			"--model-checker-threads=4",
 			"--model-checker-timeout=5",
 		};
 
@@ -174,6 +183,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.input.allowedDirectories = {"/tmp", "/home", "project", "../contracts", "c", "/usr/lib"};
 		expectedOptions.input.ignoreMissingFiles = true;
 		expectedOptions.input.errorRecovery = (inputMode == InputMode::Compiler);
+		expectedOptions.input.parserThreads = (inputMode == InputMode::Compiler ? 3 : 1);
 		expectedOptions.output.dir = "/tmp/out";
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
@@ -191,7 +201,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true, true, true, true, true,
 			true, true, true, true, true,
 			true, true, true, true, true,
-			true,
+			true, true,
 		};
 		expectedOptions.compiler.outputs.ewasmIR = false;
 		expectedOptions.compiler.estimateGas = true;
@@ -209,16 +219,23 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
+			boost::filesystem::path("smt-cache"),
 			{{{"contract1.yul", {"A"}}, {"contract2.yul", {"B"}}}},
 			true,
 			{true, false},
 			{ModelCheckerExtCalls::Mode::TRUSTED},
+			true,
 			{{InvariantType::Contract, InvariantType::Reentrancy}},
+			{smtutil::SMTPortfolio::Mode::Race},
+			true,
 			true,
 			{false, false, true, true},
+			true,
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
+			4,
 			5,
 		};
+		expectedOptions.modelChecker.progress = true;
 
 		CommandLineOptions parsedOptions = parseCommandLine(commandLine);
 
@@ -242,6 +259,27 @@ BOOST_AUTO_TEST_CASE(via_ir_options)
 		BOOST_TEST(parseCommandLine({"solc", viaIrOption, "contract.sol"}).output.viaIR);
 }
 
+BOOST_AUTO_TEST_CASE(ast_binary_requires_output_dir)
+{
+	BOOST_TEST(parseCommandLine({"solc", "--ast-binary", "--output-dir=/tmp/out", "contract.sol"}).compiler.outputs.astBinary);
+
+	string const expectedMessage = "Option --ast-binary requires --output-dir.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--ast-binary", "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+}
+
+BOOST_AUTO_TEST_CASE(stop_after_options)
+{
+	BOOST_CHECK(parseCommandLine({"solc", "contract.sol"}).output.stopAfter == CompilerStack::State::CompilationSuccessful);
+	BOOST_CHECK(parseCommandLine({"solc", "--stop-after=parsing", "contract.sol"}).output.stopAfter == CompilerStack::State::Parsed);
+	BOOST_CHECK(parseCommandLine({"solc", "--stop-after=analysis", "contract.sol"}).output.stopAfter == CompilerStack::State::AnalysisPerformed);
+
+	string const expectedMessage = "Valid options for --stop-after are: \"parsing\", \"analysis\".\n";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--stop-after=codegen", "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+	BOOST_CHECK_THROW(parseCommandLine({"solc", "--stop-after=analysis", "--bin", "contract.sol"}), CommandLineValidationError);
+}
+
 BOOST_AUTO_TEST_CASE(assembly_mode_options)
 {
 	static vector<tuple<vector<string>, YulStack::Machine, YulStack::Language>> const allowedCombinations = {
@@ -406,18 +444,27 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 	map<string, vector<string>> invalidOptionInputModeCombinations = {
 		// TODO: This should eventually contain all options.
 		{"--error-recovery", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--parser-threads=2", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--experimental-via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-literal", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-progress", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-unproved", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-slice-queries", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-div-mod-no-slacks", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-engine=bmc", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-incremental", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-invariants=contract,reentrancy", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-portfolio=race", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-solvers=z3,smtlib2", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-statistics", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-timeout=5", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-contracts=contract1.yul:A,contract2.yul:B", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
-		{"--model-checker-targets=underflow,divByZero", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}}
+		{"--model-checker-cache=smt-cache", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-targets=underflow,divByZero", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-threads=4", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--link-summary", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--import-ast"}}
 	};
 
 	for (auto const& [optionName, inputModes]: invalidOptionInputModeCombinations)